@@ -8,6 +8,7 @@
 #include <string>
 #include <gtest/gtest.h>
 #include <unordered_map>
+#include <type_traits>
 
 class MustNotCopy {
 public:
@@ -119,4 +120,13 @@ struct BadMap {
     }
 };
 
+/**
+ * Whether the inverse view type View allows erasing
+ */
+template<typename View, typename = void>
+struct can_erase : std::false_type {};
+
+template<typename View>
+struct can_erase<View, std::void_t<decltype(std::declval<View &>().erase(0))>> : std::true_type {};
+
 #endif //BIDIRECTIONALMAP_TESTUTIL_HPP
@@ -0,0 +1,208 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "bidirectional_map.hpp"
+#include "adaptive_map.hpp"
+
+TEST(AdaptiveMap, random_against_map) {
+    using namespace bimap;
+    adaptive_map<int, int> test;
+    std::map<int, int> reference;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(0, 3000);
+    for (int round = 0; round < 20000; ++round) {
+        auto key = dist(gen);
+        if (round % 3 == 0) {
+            ASSERT_EQ(test.erase(key), reference.erase(key));
+        } else {
+            ASSERT_EQ(test.emplace(key, round).second, reference.emplace(key, round).second);
+        }
+
+        if (round % 97 == 0) {
+            auto it = test.lower_bound(key);
+            auto refIt = reference.lower_bound(key);
+            for (int i = 0; i < 10 && refIt != reference.end(); ++i, ++it, ++refIt) {
+                ASSERT_NE(it, test.end());
+                ASSERT_EQ(*it, *refIt);
+            }
+        }
+    }
+
+    ASSERT_EQ(test.size(), reference.size());
+    EXPECT_EQ(static_cast<std::size_t>(std::distance(test.begin(), test.end())), reference.size());
+    for (const auto &[key, value] : reference) {
+        auto it = test.find(key);
+        ASSERT_NE(it, test.end());
+        EXPECT_EQ(it->second, value);
+    }
+
+    EXPECT_TRUE(std::equal(test.lower_bound(-1), test.end(), reference.begin(), reference.end()));
+    auto it = test.upper_bound(1500);
+    auto refIt = reference.upper_bound(1500);
+    while (it != test.end()) {
+        ASSERT_EQ(it->first, refIt->first);
+        it = test.erase(it);
+        refIt = reference.erase(refIt);
+    }
+
+    EXPECT_TRUE(std::equal(test.lower_bound(-1), test.end(), reference.begin(), reference.end()));
+}
+
+TEST(AdaptiveMap, migrations_keep_references) {
+    using namespace bimap;
+    adaptive_map<std::string, int> test;
+    auto &first = *test.emplace("0", 0).first;
+    EXPECT_TRUE(test.is_small());
+    for (int i = 1; i < 100; ++i) {
+        test.emplace(std::to_string(i), i);
+    }
+
+    EXPECT_FALSE(test.is_small());
+    EXPECT_EQ(&*test.find("0"), &first);
+    EXPECT_FALSE(test.has_ordered_index());
+    EXPECT_EQ(test.lower_bound("5")->first, "5");
+    EXPECT_TRUE(test.has_ordered_index());
+    auto it = test.lower_bound("98");
+    for (int i = 100; i < 400; ++i) {
+        test.emplace(std::to_string(i), i);
+    }
+
+    // tail outgrew the sorted index without ordered queries
+    EXPECT_FALSE(test.has_ordered_index());
+    EXPECT_EQ(it->first, "98");
+    EXPECT_EQ((++it)->first, "99");
+    for (int i = 1; i < 400; ++i) {
+        test.erase(std::to_string(i));
+    }
+
+    EXPECT_TRUE(test.is_small());
+    EXPECT_EQ(test.size(), 1);
+    EXPECT_EQ(&*test.begin(), &first);
+    test.clear();
+    EXPECT_TRUE(test.empty());
+    EXPECT_EQ(test.begin(), test.end());
+}
+
+TEST(AdaptiveMap, copy_and_compare) {
+    using namespace bimap;
+    adaptive_map<int, int> test;
+    for (int i = 0; i < 50; ++i) {
+        test.emplace(i, i * i);
+    }
+
+    test.lower_bound(0);
+    auto copy = test;
+    EXPECT_EQ(copy, test);
+    copy.erase(3);
+    EXPECT_NE(copy, test);
+    swap(copy, test);
+    EXPECT_EQ(test.size(), 49);
+    EXPECT_EQ(copy.count(3), 1);
+}
+
+TEST(AdaptiveMap, erase_from_copy) {
+    using namespace bimap;
+    adaptive_map<int, int> test;
+    for (int i = 0; i < 100; ++i) {
+        test.emplace(i, -i);
+    }
+
+    auto copy = test;
+    adaptive_map<int, int> assigned;
+    assigned = test;
+    for (int i = 0; i < 100; i += 2) {
+        EXPECT_EQ(copy.erase(i), 1);
+        EXPECT_EQ(assigned.erase(i), 1);
+    }
+
+    EXPECT_EQ(copy.size(), 50);
+    EXPECT_EQ(assigned, copy);
+    EXPECT_EQ(test.size(), 100);
+    int expected = 1;
+    for (const auto &item : copy) {
+        EXPECT_EQ(item.first, expected);
+        expected += 2;
+    }
+
+    // erased slots are reused
+    for (int i = 0; i < 100; i += 2) {
+        EXPECT_TRUE(copy.emplace(i, i).second);
+    }
+
+    EXPECT_EQ(copy.size(), 100);
+    EXPECT_EQ(copy.find(42)->second, 42);
+}
+
+TEST(AdaptiveMap, oscillation_after_peak) {
+    using namespace bimap;
+    using Map = adaptive_map<int, int>;
+    Map test;
+    constexpr int Peak = 5000;
+    for (int i = 0; i < Peak; ++i) {
+        test.emplace(i, i);
+    }
+
+    EXPECT_GE(test.index_capacity(), 2 * test.size());
+    // the table shrinks along with the elements instead of staying at its peak size
+    for (int i = 0; i < Peak - 2; ++i) {
+        test.erase(i);
+        if (!test.is_small()) {
+            EXPECT_LE(test.index_capacity(), 8 * test.size());
+        }
+    }
+
+    EXPECT_TRUE(test.is_small());
+    EXPECT_EQ(test.index_capacity(), Map::small_size);
+    EXPECT_EQ(test.begin()->first, Peak - 2);
+    EXPECT_EQ(std::prev(test.end())->first, Peak - 1);
+    // every round migrates to the table and back to the inline array
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            test.emplace(i, i);
+            EXPECT_EQ(test.is_small(), test.size() <= Map::small_size);
+        }
+
+        // same table size as a map that never grew beyond 10 elements
+        EXPECT_EQ(test.index_capacity(), 4 * Map::small_size);
+        for (int i = 0; i < 8; ++i) {
+            test.erase(i);
+            EXPECT_EQ(test.is_small(), test.size() < Map::small_size / 2);
+        }
+
+        EXPECT_TRUE(test.is_small());
+    }
+
+    std::vector<int> keys;
+    for (const auto &item : test) {
+        keys.emplace_back(item.first);
+    }
+
+    EXPECT_EQ(keys, (std::vector<int>{Peak - 2, Peak - 1}));
+}
+
+TEST(AdaptiveMap, bidirectional_map) {
+    using namespace bimap;
+    bidirectional_map<std::string, int, adaptive_map, adaptive_map> map;
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(map.emplace(std::to_string(i), i).second);
+    }
+
+    EXPECT_FALSE(map.emplace("x", 5).second);
+    EXPECT_EQ(map.at("17"), 17);
+    EXPECT_EQ(map.inverse().at(42), "42");
+    int expected = 100;
+    for (auto it = map.inverse().lower_bound(100); it != map.inverse().end(); ++it) {
+        EXPECT_EQ(it->first, expected++);
+    }
+
+    EXPECT_EQ(expected, 200);
+    map.erase("17");
+    EXPECT_FALSE(map.inverse().contains(17));
+    EXPECT_EQ(map.size(), 199);
+}
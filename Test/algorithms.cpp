@@ -0,0 +1,207 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <mutex>
+#include <set>
+#include <atomic>
+#include <execution>
+#include <random>
+
+#include "bidirectional_map.hpp"
+#include "algorithms.hpp"
+
+TEST(Algorithms, for_each_count_if) {
+    using namespace bimap;
+    bidirectional_map<int, std::string> test;
+    for (int i = 0; i < 5000; ++i) {
+        test.emplace(i, std::to_string(i));
+    }
+
+    std::mutex mutex;
+    std::set<int> visited;
+    bimap::for_each(std::execution::par, test, [&](int key, const std::string &value) {
+        EXPECT_EQ(std::to_string(key), value);
+        std::lock_guard lock(mutex);
+        visited.emplace(key);
+    });
+
+    EXPECT_EQ(visited.size(), test.size());
+    std::atomic<long> sum{0};
+    bimap::for_each(std::execution::seq, test.inverse(), [&](const std::string &, int key) { sum += key; });
+    EXPECT_EQ(sum, 4999L * 5000L / 2);
+    auto even = [](int key, const std::string &) { return key % 2 == 0; };
+    EXPECT_EQ(bimap::count_if(std::execution::par_unseq, test, even), 2500);
+    EXPECT_EQ(bimap::count_if(std::execution::seq, test, even), 2500);
+    bidirectional_map<int, int, std::map, std::multimap> ordered;
+    for (int i = 0; i < 3000; ++i) {
+        ordered.emplace(i, i % 10);
+    }
+
+    EXPECT_EQ(bimap::count_if(std::execution::par, ordered.inverse(), [](int value, int) { return value == 3; }),
+              300);
+}
+
+TEST(Algorithms, erase_if) {
+    using namespace bimap;
+    bidirectional_map<int, int> test;
+    bidirectional_map<int, int, std::map, std::unordered_multimap> multi;
+    for (int i = 0; i < 5000; ++i) {
+        test.emplace(i, -i);
+        multi.emplace(i, i % 7);
+    }
+
+    EXPECT_EQ(bimap::erase_if(std::execution::par, test, [](int key, int) { return key % 3 != 0; }), 3333);
+    EXPECT_EQ(test.size(), 1667);
+    EXPECT_EQ(test.inverse().size(), 1667);
+    for (const auto &[key, value] : test) {
+        EXPECT_EQ(key % 3, 0);
+        EXPECT_EQ(test.inverse().at(value), key);
+    }
+
+    EXPECT_EQ(bimap::erase_if(std::execution::seq, test, [](int, int) { return false; }), 0);
+    auto erased = bimap::erase_if(std::execution::par, multi.inverse(), [](int value, int key) {
+        return value == 2 && key > 100;
+    });
+
+    EXPECT_EQ(erased, 699);
+    EXPECT_EQ(multi.size(), multi.inverse().size());
+    auto [first, last] = multi.inverse().equal_range(2);
+    EXPECT_EQ(std::distance(first, last), 15);
+    EXPECT_FALSE(multi.contains(2 + 7 * 20));
+    EXPECT_TRUE(multi.contains(2 + 7 * 10));
+}
+
+template<template<typename ...> typename Map>
+void testSetOperations() {
+    using namespace bimap;
+    bidirectional_map<int, std::string, Map, Map> lhs = {{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
+    bidirectional_map<int, std::string, Map, Map> rhs = {{2, "b"}, {3, "x"}, {5, "e"}, {6, "a"}, {7, "f"}};
+    auto both = intersect(lhs, rhs);
+    EXPECT_EQ(both.map, (bidirectional_map<int, std::string, Map, Map>{{2, "b"}}));
+    ASSERT_EQ(both.conflicts.size(), 1);
+    EXPECT_EQ(both.conflicts.front().key, 3);
+    EXPECT_EQ(both.conflicts.front().lhs, "c");
+    EXPECT_EQ(both.conflicts.front().rhs, "x");
+    EXPECT_EQ(intersect(rhs, lhs).map, both.map);
+
+    auto onlyLhs = difference(lhs, rhs);
+    EXPECT_EQ(onlyLhs.map, (bidirectional_map<int, std::string, Map, Map>{{1, "a"}, {3, "c"}, {4, "d"}}));
+    EXPECT_EQ(onlyLhs.conflicts.size(), 1);
+    EXPECT_EQ(onlyLhs.map.inverse().at("c"), 3);
+
+    auto all = merge_union(lhs, rhs);
+    EXPECT_EQ(all.map, (bidirectional_map<int, std::string, Map, Map>{{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"},
+                                                                     {5, "e"}, {7, "f"}}));
+    ASSERT_EQ(all.conflicts.size(), 1);
+    EXPECT_EQ(all.conflicts.front().rhs, "x");
+    ASSERT_EQ(all.inverse_conflicts.size(), 1);
+    EXPECT_EQ(all.inverse_conflicts.front().key, "a");
+    EXPECT_EQ(all.inverse_conflicts.front().lhs, 1);
+    EXPECT_EQ(all.inverse_conflicts.front().rhs, 6);
+    EXPECT_EQ(all.map.inverse().size(), all.map.size());
+}
+
+TEST(Algorithms, set_operations) {
+    testSetOperations<std::unordered_map>();
+    testSetOperations<std::map>();
+}
+
+TEST(Algorithms, compose) {
+    using namespace bimap;
+    bidirectional_map<std::string, int> external;
+    bidirectional_map<int, std::string, std::map> shards;
+    for (int i = 0; i < 3000; ++i) {
+        external.emplace("ext" + std::to_string(i), i);
+        if (i % 3 != 0) {
+            shards.emplace(i, "shard" + std::to_string(i));
+        }
+    }
+
+    auto composed = compose(external, shards);
+    EXPECT_EQ(composed.size(), 2000);
+    EXPECT_EQ(composed.at("ext10"), "shard10");
+    EXPECT_FALSE(composed.contains("ext9"));
+    EXPECT_EQ(composed.inverse().at("shard11"), "ext11");
+    EXPECT_EQ(compose(std::execution::par, external, shards), composed);
+    EXPECT_EQ(compose(std::execution::seq, external, shards), composed);
+
+    composed_view view(external, shards);
+    EXPECT_EQ(view.at("ext10"), "shard10");
+    EXPECT_TRUE(view.contains("ext11"));
+    EXPECT_FALSE(view.contains("ext9"));
+    EXPECT_FALSE(view.contains("none"));
+    EXPECT_THROW(view.at("ext9"), std::out_of_range);
+    EXPECT_EQ(view.inverse().at("shard20"), "ext20");
+    EXPECT_EQ(view.materialize(), composed);
+    shards.emplace(9, "shard9");
+    EXPECT_EQ(view.at("ext9"), "shard9");
+}
+
+template<template<typename ...> typename Map>
+void testDiff() {
+    using namespace bimap;
+    bidirectional_map<int, int, Map, Map> from, to;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> dist(0, 3000);
+    for (int i = 0; i < 2000; ++i) {
+        from.emplace(dist(gen), dist(gen));
+        to.emplace(dist(gen), dist(gen));
+    }
+
+    for (int i = 0; i < 500; ++i) {
+        auto key = dist(gen);
+        to.emplace(key, from.contains(key) ? from.at(key) : key);
+    }
+
+    auto changes = diff(from, to);
+    EXPECT_EQ(changes.insertions.size() + from.size(), changes.erasures.size() + to.size());
+    auto parChanges = diff(std::execution::par, from, to);
+    EXPECT_EQ(parChanges.erasures.size(), changes.erasures.size());
+    EXPECT_EQ(parChanges.insertions.size(), changes.insertions.size());
+    auto copy = from;
+    copy.apply(changes);
+    EXPECT_EQ(copy, to);
+    EXPECT_EQ(copy.inverse(), to.inverse());
+    from.apply(parChanges);
+    EXPECT_EQ(from, to);
+    EXPECT_TRUE(diff(from, to).empty());
+}
+
+TEST(Algorithms, diff_apply) {
+    testDiff<std::unordered_map>();
+    testDiff<std::map>();
+}
+
+TEST(Algorithms, export_columns) {
+    using namespace bimap;
+    bidirectional_map<int, std::string> test;
+    bidirectional_map<int, std::string, std::map> ordered;
+    for (int i = 0; i < 5000; ++i) {
+        test.emplace(i * 7 % 5000, std::to_string(i));
+        ordered.emplace(i * 7 % 5000, std::to_string(i));
+    }
+
+    std::vector<int> keys(test.size());
+    std::vector<std::string> values(test.size());
+    EXPECT_EQ(export_columns(std::execution::par, test, keys.begin(), values.data()), test.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(test.at(keys[i]), values[i]);
+    }
+
+    std::vector<int> sortedKeys(test.size());
+    std::vector<std::string> sortedValues(test.size());
+    export_sorted_columns(std::execution::par, test, sortedKeys.begin(), sortedValues.begin());
+    EXPECT_TRUE(std::is_sorted(sortedKeys.begin(), sortedKeys.end()));
+    std::vector<int> orderedKeys(test.size());
+    std::vector<std::string> orderedValues(test.size());
+    export_columns(std::execution::par, ordered, orderedKeys.begin(), orderedValues.begin());
+    EXPECT_EQ(orderedKeys, sortedKeys);
+    EXPECT_EQ(orderedValues, sortedValues);
+    std::vector<std::string> inverseKeys(test.size());
+    export_columns(test.inverse(), inverseKeys.begin(), keys.begin());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(test.inverse().at(inverseKeys[i]), keys[i]);
+    }
+}
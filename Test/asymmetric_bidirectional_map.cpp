@@ -0,0 +1,175 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <random>
+#include <utility>
+#include <stdexcept>
+#include <vector>
+
+#include "asymmetric_bidirectional_map.hpp"
+
+TEST(AsymmetricBidirectionalMap, inverse_queries) {
+    using namespace bimap;
+    asymmetric_bidirectional_map<std::string, int> map;
+    EXPECT_TRUE(map.emplace("a", 3).second);
+    EXPECT_TRUE(map.emplace("b", 1).second);
+    EXPECT_TRUE(map.emplace("c", 1).second);
+    EXPECT_FALSE(map.emplace("a", 7).second);
+    EXPECT_TRUE(map.emplace("d", 5).second);
+    EXPECT_FALSE(map.merged());
+    EXPECT_THROW(std::as_const(map).inverse(), std::logic_error);
+    auto copy = map;
+    EXPECT_EQ(map.merge(), (std::vector<std::pair<std::string, int>>{{"c", 1}}));
+    EXPECT_TRUE(map.merged());
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(std::as_const(map).inverse().at(3), "a");
+    EXPECT_EQ(map.inverse().lower_bound(2)->second, "a");
+    EXPECT_EQ(map.inverse().upper_bound(3)->first, 5);
+    EXPECT_EQ(map.inverse().lower_bound(6), map.inverse().end());
+    EXPECT_FALSE(map.inverse().contains(2));
+    EXPECT_THROW(map.inverse().at(2), std::out_of_range);
+    EXPECT_EQ(map.erase("a"), 1);
+    EXPECT_FALSE(map.merged());
+    EXPECT_TRUE(map.emplace("e", 3).second);
+    std::vector<std::pair<int, std::string>> items(map.inverse().begin(), map.inverse().end());
+    EXPECT_EQ(items, (std::vector<std::pair<int, std::string>>{{1, "b"}, {3, "e"}, {5, "d"}}));
+    EXPECT_EQ(copy.size(), 4);
+    EXPECT_EQ(copy.inverse().at(1), "b");
+    map.clear();
+    EXPECT_TRUE(map.inverse().empty());
+}
+
+TEST(AsymmetricBidirectionalMap, tail_erase_keeps_insertion_order) {
+    using namespace bimap;
+    asymmetric_bidirectional_map<std::string, int> map;
+    map.emplace("x", 9);
+    map.emplace("a", 1);
+    map.emplace("c", 1);
+    EXPECT_EQ(map.erase("x"), 1);
+    auto rejected = map.merge();
+    EXPECT_EQ(rejected, (std::vector<std::pair<std::string, int>>{{"c", 1}}));
+    EXPECT_EQ(map.inverse().at(1), "a");
+    EXPECT_FALSE(map.contains("c"));
+}
+
+struct ThrowingCopy {
+    static inline int copiesUntilThrow = -1;
+    int value;
+
+    ThrowingCopy(int value) noexcept: value(value) {}
+
+    ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+        if (copiesUntilThrow >= 0 && copiesUntilThrow-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+
+    ThrowingCopy &operator=(const ThrowingCopy &) = default;
+
+    bool operator<(const ThrowingCopy &other) const noexcept {
+        return value < other.value;
+    }
+};
+
+TEST(AsymmetricBidirectionalMap, throwing_merge) {
+    using namespace bimap;
+    asymmetric_bidirectional_map<int, ThrowingCopy> map;
+    map.emplace(1, 10);
+    map.emplace(2, 20);
+    EXPECT_TRUE(map.merge().empty());
+    map.erase(1);
+    map.emplace(3, 30);
+    map.emplace(4, 40);
+    map.emplace(5, 40);
+    // the third copy of an inverse key during the merge throws
+    ThrowingCopy::copiesUntilThrow = 2;
+    EXPECT_THROW(map.merge(), std::runtime_error);
+    ThrowingCopy::copiesUntilThrow = -1;
+    EXPECT_FALSE(map.merged());
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.erase(3), 1);
+    auto rejected = map.merge();
+    ASSERT_EQ(rejected.size(), 1);
+    EXPECT_EQ(rejected.front().first, 5);
+    EXPECT_TRUE(map.merged());
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.inverse().size(), 2);
+    EXPECT_EQ(map.inverse().at(20), 2);
+    EXPECT_EQ(map.inverse().at(40), 4);
+    EXPECT_FALSE(map.inverse().contains(10));
+    EXPECT_FALSE(map.inverse().contains(30));
+}
+
+TEST(AsymmetricBidirectionalMap, random_operations) {
+    using namespace bimap;
+    asymmetric_bidirectional_map<int, int> map;
+    std::map<int, int> inverse;
+    std::unordered_map<int, int> forward;
+    std::mt19937 gen(21);
+    std::uniform_int_distribution<int> dist(0, 5000);
+    for (int i = 0; i < 50000; ++i) {
+        const auto key = dist(gen), value = dist(gen);
+        switch (gen() % 8) {
+            case 0: {
+                if (auto it = forward.find(key); it != forward.end()) {
+                    inverse.erase(it->second);
+                    forward.erase(it);
+                }
+                EXPECT_LE(map.erase(key), 1);
+                break;
+            }
+            case 1: {
+                auto res = map.inverse().lower_bound(value);
+                auto expected = inverse.lower_bound(value);
+                ASSERT_EQ(res == map.inverse().end(), expected == inverse.end());
+                if (expected != inverse.end()) {
+                    EXPECT_EQ(res->first, expected->first);
+                    EXPECT_EQ(res->second, expected->second);
+                }
+                break;
+            }
+            default: {
+                auto [it, inserted] = map.emplace(key, value);
+                if (forward.count(key) == 1) {
+                    EXPECT_FALSE(inserted);
+                } else if (inverse.count(value) == 1) {
+                    // the conflict is detected by an automatic merge or by the next explicit merge
+                    auto rejected = map.merge();
+                    EXPECT_TRUE(!inserted || rejected == (std::vector<std::pair<int, int>>{{key, value}}));
+                    EXPECT_FALSE(map.contains(key));
+                } else {
+                    EXPECT_TRUE(inserted);
+                    forward.emplace(key, value);
+                    inverse.emplace(value, key);
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(map.size(), forward.size());
+    std::vector<std::pair<int, int>> items(map.inverse().begin(), map.inverse().end());
+    EXPECT_EQ(items, (std::vector<std::pair<int, int>>(inverse.begin(), inverse.end())));
+}
+
+TEST(AsymmetricBidirectionalMap, automatic_merge) {
+    using namespace bimap;
+    asymmetric_bidirectional_map<int, int> map;
+    using Map = decltype(map);
+    for (int i = 0; i < static_cast<int>(Map::MinTail); ++i) {
+        EXPECT_TRUE(map.emplace(i, 2 * i).second);
+    }
+
+    EXPECT_FALSE(map.merged());
+    auto [it, inserted] = map.emplace(1000, 4);
+    EXPECT_TRUE(map.merged());
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(it->first, 2);
+    EXPECT_FALSE(map.contains(1000));
+    EXPECT_TRUE(map.merge().empty());
+    EXPECT_TRUE(map.emplace(1000, 1).second);
+    EXPECT_EQ(std::as_const(map).find(1000)->second, 1);
+}
@@ -0,0 +1,59 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "bidirectional_index_view.hpp"
+
+template<template<typename ...> typename ForwardIndex, template<typename ...> typename InverseIndex>
+void testIndexView() {
+    using namespace bimap;
+    std::vector<std::string> names;
+    std::vector<std::uint64_t> ids;
+    for (std::uint64_t i = 0; i < 2000; ++i) {
+        names.emplace_back("name" + std::to_string(i));
+        ids.emplace_back(i * 31 + 7);
+    }
+
+    bidirectional_index_view<std::string, std::uint64_t, ForwardIndex, InverseIndex> view(names.data(), ids.data(),
+                                                                                         names.size());
+    EXPECT_EQ(view.size(), 2000);
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        ASSERT_EQ(view.find(names[i]), i);
+        EXPECT_EQ(view.at(names[i]), ids[i]);
+        EXPECT_EQ(&view.inverse().at(ids[i]), &names[i]);
+    }
+
+    EXPECT_FALSE(view.contains("name2000"));
+    EXPECT_EQ(view.find("abc"), npos);
+    EXPECT_FALSE(view.inverse().contains(8));
+    EXPECT_THROW(view.at("abc"), std::out_of_range);
+    EXPECT_THROW(view.inverse().at(0), std::out_of_range);
+}
+
+TEST(BidirectionalIndexView, lookup) {
+    using namespace bimap;
+    testIndexView<hash_index, hash_index>();
+    testIndexView<sorted_index, hash_index>();
+    testIndexView<hash_index, sorted_index>();
+}
+
+TEST(BidirectionalIndexView, duplicates_and_empty) {
+    using namespace bimap;
+    std::vector<int> keys = {1, 2, 3, 2};
+    std::vector<int> values = {4, 5, 6, 7};
+    EXPECT_THROW((bidirectional_index_view<int, int>(keys.data(), values.data(), keys.size())),
+                 std::invalid_argument);
+    EXPECT_THROW((bidirectional_index_view<int, int, hash_index, sorted_index>(values.data(), keys.data(),
+                                                                               keys.size())),
+                 std::invalid_argument);
+    bidirectional_index_view<int, int, sorted_index, sorted_index> view(keys.data(), values.data(), 3);
+    EXPECT_EQ(view.inverse().at(6), 3);
+    EXPECT_EQ(view.forward_index().rows(), (std::vector<std::size_t>{0, 1, 2}));
+    bidirectional_index_view<int, int> empty(nullptr, nullptr, 0);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.contains(1));
+}
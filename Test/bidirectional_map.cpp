@@ -592,3 +592,61 @@ TEST(BidirectionalMap, ranges_unordered) {
     checkValues(invCurr, 456, "NewItem");
     EXPECT_EQ(++invCurr, invLast);
 }
+
+TEST(BidirectionalMap, fingerprint) {
+    using namespace bimap;
+    bidirectional_map<std::string, int> test = {{"Test", 123}, {"NewItem", 456}, {"Stuff", 789}};
+    bidirectional_map<std::string, int, std::map, std::map> other = {{"Stuff", 789}, {"Test", 123}, {"NewItem", 456}};
+    EXPECT_EQ(test.fingerprint(), other.fingerprint());
+    EXPECT_EQ(test.inverse().fingerprint(), other.inverse().fingerprint());
+    EXPECT_NE(test.fingerprint(), test.inverse().fingerprint());
+    auto copy = test;
+    copy.erase("Test");
+    EXPECT_NE(copy.fingerprint(), test.fingerprint());
+    EXPECT_NE(copy, test);
+    copy.inverse().emplace(123, "Test");
+    EXPECT_EQ(copy.fingerprint(), test.fingerprint());
+    EXPECT_EQ(copy.inverse().fingerprint(), test.inverse().fingerprint());
+    EXPECT_EQ(copy, test);
+    copy.emplace("Test", 1);
+    EXPECT_EQ(copy.fingerprint(), test.fingerprint());
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved.fingerprint(), test.fingerprint());
+    EXPECT_EQ(moved.inverse().fingerprint(), test.inverse().fingerprint());
+    moved.clear();
+    EXPECT_EQ(moved.fingerprint(), (bidirectional_map<std::string, int>().fingerprint()));
+    EXPECT_EQ(moved.inverse().fingerprint(), 0);
+}
+
+TEST(BidirectionalMap, memory_usage) {
+    using namespace bimap;
+    bidirectional_map<std::string, int, std::unordered_map, std::map> test;
+    const std::string longKey(100, 'x');
+    test.emplace("short", 1);
+    test.emplace(longKey, 2);
+    auto usage = test.memory_usage();
+    EXPECT_EQ(usage.forward_key_storage, heap_size<std::string>{}(test.find(longKey)->first));
+    EXPECT_GT(usage.forward_key_storage, 100);
+    EXPECT_EQ(usage.inverse_key_storage, 0);
+    EXPECT_GE(usage.forward_nodes, 2 * (sizeof(std::string) + sizeof(void *)));
+    EXPECT_GE(usage.inverse_nodes, 2 * (sizeof(int) + sizeof(void *)));
+    EXPECT_GT(usage.forward_buckets, 0);
+    EXPECT_EQ(usage.inverse_buckets, 0);
+    EXPECT_GT(usage.inverse_object, 0);
+    auto inverseUsage = test.inverse().memory_usage();
+    EXPECT_EQ(inverseUsage.forward_key_storage, usage.inverse_key_storage);
+    EXPECT_EQ(inverseUsage.inverse_key_storage, usage.forward_key_storage);
+    EXPECT_EQ(inverseUsage.forward_nodes, usage.inverse_nodes);
+    EXPECT_EQ(inverseUsage.total(), usage.total());
+
+    auto copy = test;
+    EXPECT_EQ(copy.memory_usage().forward_key_storage, usage.forward_key_storage);
+    test.erase(longKey);
+    EXPECT_EQ(test.memory_usage().forward_key_storage, 0);
+    EXPECT_LT(test.memory_usage().forward_nodes, usage.forward_nodes);
+    swap(test, copy);
+    EXPECT_EQ(test.memory_usage().forward_key_storage, usage.forward_key_storage);
+    test.clear();
+    EXPECT_EQ(test.memory_usage().forward_key_storage, 0);
+    EXPECT_EQ(test.memory_usage().forward_nodes, 0);
+}
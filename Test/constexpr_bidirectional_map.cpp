@@ -0,0 +1,44 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+#include "constexpr_bidirectional_map.hpp"
+
+namespace {
+    enum class Op {
+        Add, Sub, Mul, Div
+    };
+
+    using namespace std::string_view_literals;
+    constexpr auto Ops = bimap::make_constexpr_bidirectional_map<Op, std::string_view>({{Op::Mul, "mul"},
+                                                                                       {Op::Add, "add"},
+                                                                                       {Op::Div, "div"},
+                                                                                       {Op::Sub, "sub"}});
+    static_assert(Ops.size() == 4);
+    static_assert(Ops.at(Op::Sub) == "sub"sv);
+    static_assert(Ops.inverse().at("div") == Op::Div);
+    static_assert(Ops.contains(Op::Add) && !Ops.inverse().contains("mod"));
+    static_assert(Ops.inverse().inverse().at(Op::Mul) == "mul"sv);
+    static_assert(Ops.begin()->first == Op::Add);
+}
+
+TEST(ConstexprBidirectionalMap, lookup) {
+    using namespace bimap;
+    EXPECT_EQ(Ops.at(Op::Add), "add");
+    EXPECT_EQ(Ops.find(Op::Div)->second, "div");
+    EXPECT_EQ(Ops.inverse().find("sub")->second, Op::Sub);
+    EXPECT_EQ(Ops.inverse().find("mod"), Ops.inverse().end());
+    EXPECT_THROW(Ops.inverse().at("mod"), std::out_of_range);
+    std::vector<std::string_view> names;
+    for (auto [name, op] : Ops.inverse()) {
+        names.emplace_back(name);
+    }
+
+    EXPECT_EQ(names, (std::vector<std::string_view>{"add", "div", "mul", "sub"}));
+    constexpr auto identity = make_constexpr_bidirectional_map<int, int>({{1, 3}, {2, 2}, {3, 1}});
+    static_assert(identity.inverse().at(1) == 3);
+    EXPECT_THROW((make_constexpr_bidirectional_map<int, int>({{1, 3}, {2, 3}})), std::invalid_argument);
+}
@@ -0,0 +1,137 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <type_traits>
+
+#include "dense_bidirectional_map.hpp"
+#include "TestUtil.hpp"
+
+TEST(DenseBidirectionalMap, insertion_order) {
+    using namespace bimap;
+    dense_bidirectional_map<std::string, int> map;
+    EXPECT_FALSE(map.contains("a"));
+    EXPECT_EQ(map.erase("a"), 0);
+    EXPECT_FALSE(map.inverse().contains(1));
+    EXPECT_TRUE(map.emplace("c", 3).second);
+    EXPECT_TRUE(map.emplace("a", 1).second);
+    EXPECT_TRUE(map.emplace("b", 2).second);
+    EXPECT_FALSE(map.emplace("a", 4).second);
+    EXPECT_EQ(map.emplace("d", 2).first->first, "b");
+    EXPECT_EQ(map.at("a"), 1);
+    EXPECT_EQ(map.inverse().at(3), "c");
+    EXPECT_THROW(map.at("d"), std::out_of_range);
+    EXPECT_EQ(map.erase("a"), 1);
+    EXPECT_TRUE(map.emplace("a", 5).second);
+    std::vector<std::pair<std::string, int>> items(map.begin(), map.end());
+    EXPECT_EQ(items, (std::vector<std::pair<std::string, int>>{{"c", 3}, {"b", 2}, {"a", 5}}));
+    std::vector<std::pair<int, std::string>> inverseItems(map.inverse().begin(), map.inverse().end());
+    EXPECT_EQ(inverseItems, (std::vector<std::pair<int, std::string>>{{3, "c"}, {2, "b"}, {5, "a"}}));
+    EXPECT_EQ(map.inverse().erase(3), 1);
+    map.compact();
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.begin()->first, "b");
+    EXPECT_EQ(map.inverse().inverse().at("a"), 5);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(DenseBidirectionalMap, random_operations) {
+    using namespace bimap;
+    dense_bidirectional_map<int, int> map;
+    std::vector<int> order;
+    std::mt19937 gen(4);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    for (int i = 0; i < 30000; ++i) {
+        const auto key = dist(gen);
+        const auto pos = std::find(order.begin(), order.end(), key);
+        if (gen() % 2 == 0) {
+            EXPECT_EQ(map.emplace(key, key + 1).second, pos == order.end());
+            if (pos == order.end()) {
+                order.emplace_back(key);
+            }
+        } else {
+            const auto erased = gen() % 2 == 0 ? map.erase(key) : map.inverse().erase(key + 1);
+            EXPECT_EQ(erased, pos != order.end());
+            if (pos != order.end()) {
+                order.erase(pos);
+            }
+        }
+    }
+
+    ASSERT_EQ(map.size(), order.size());
+    auto it = order.begin();
+    for (auto [key, value] : map) {
+        EXPECT_EQ(key, *it++);
+        EXPECT_EQ(value, key + 1);
+        EXPECT_EQ(map.inverse().at(value), key);
+    }
+}
+
+TEST(DenseBidirectionalMap, compaction_with_strings) {
+    using namespace bimap;
+    dense_bidirectional_map<std::string, int> map;
+    for (int i = 0; i < 8; ++i) {
+        map.emplace("key" + std::to_string(i), i);
+    }
+
+    // erasing more than half of the entries triggers compaction
+    for (int i = 2; i < 7; ++i) {
+        EXPECT_EQ(map.erase("key" + std::to_string(i)), 1);
+    }
+
+    std::vector<std::pair<std::string, int>> items(map.begin(), map.end());
+    EXPECT_EQ(items, (std::vector<std::pair<std::string, int>>{{"key0", 0}, {"key1", 1}, {"key7", 7}}));
+    EXPECT_TRUE(map.contains("key0"));
+    EXPECT_EQ(map.inverse().at(1), "key1");
+    map.erase("key1");
+    map.compact();
+    EXPECT_EQ(map.at("key0"), 0);
+    EXPECT_EQ(map.at("key7"), 7);
+    EXPECT_EQ(map.begin()->first, "key0");
+}
+
+TEST(DenseBidirectionalMap, many_insertions) {
+    using namespace bimap;
+    dense_bidirectional_map<int, int> map;
+    constexpr int NumItems = 200000;
+    std::size_t reallocations = 0;
+    const int *first = nullptr;
+    for (int i = 0; i < NumItems; ++i) {
+        ASSERT_TRUE(map.emplace(i, NumItems - i).second);
+        if (&map.begin()->first != first) {
+            first = &map.begin()->first;
+            ++reallocations;
+        }
+    }
+
+    // the entry vector grows geometrically
+    EXPECT_LT(reallocations, 64);
+    EXPECT_EQ(map.size(), NumItems);
+    for (int i = 0; i < NumItems; i += 997) {
+        EXPECT_EQ(map.at(i), NumItems - i);
+        EXPECT_EQ(map.inverse().at(NumItems - i), i);
+    }
+}
+
+TEST(DenseBidirectionalMap, const_inverse) {
+    using namespace bimap;
+    using Map = dense_bidirectional_map<int, int>;
+    Map map;
+    map.emplace(1, 2);
+    const auto &constMap = map;
+    auto view = constMap.inverse();
+    static_assert(std::is_same_v<decltype(view), Map::const_inverse_view>);
+    static_assert(std::is_same_v<decltype(view.inverse()), const Map &>);
+    static_assert(!can_erase<Map::const_inverse_view>::value);
+    static_assert(can_erase<Map::inverse_view>::value);
+    EXPECT_EQ(view.at(2), 1);
+    Map::const_inverse_view converted = map.inverse();
+    EXPECT_EQ(converted.find(2)->second, 1);
+    EXPECT_EQ(&converted.inverse(), &map);
+}
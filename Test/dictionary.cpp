@@ -0,0 +1,68 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <execution>
+
+#include "bidirectional_map.hpp"
+#include "dictionary.hpp"
+
+TEST(Dictionary, encode_decode) {
+    using namespace bimap;
+    bidirectional_map<std::string, std::uint32_t> dictionary = {{"known", 0}};
+    std::vector<std::string> column;
+    for (int i = 0; i < 3000; ++i) {
+        column.emplace_back(i % 5 == 0 ? std::string("known") : "value" + std::to_string(i % 700));
+    }
+
+    std::vector<std::string_view> views(column.begin(), column.end());
+    std::vector<std::uint32_t> ids(column.size());
+    EXPECT_EQ(encode(std::execution::par, dictionary, views.begin(), views.end(), ids.begin()), 560);
+    EXPECT_EQ(dictionary.size(), 561);
+    EXPECT_EQ(ids[0], 0);
+    EXPECT_EQ(ids[1], 1);
+    EXPECT_EQ(ids[2], 2);
+    EXPECT_EQ(ids[701], ids[1]);
+    std::vector<std::uint32_t> sequentialIds(column.size());
+    EXPECT_EQ(encode(dictionary, column.begin(), column.end(), sequentialIds.begin()), 0);
+    EXPECT_EQ(sequentialIds, ids);
+
+    std::vector<std::string_view> decoded(ids.size());
+    decode(std::execution::par, dictionary, ids.begin(), ids.end(), decoded.begin());
+    EXPECT_EQ(decoded, views);
+    std::vector<std::string> copies(ids.size());
+    decode(dictionary, ids.begin(), ids.end(), copies.begin());
+    EXPECT_EQ(copies, column);
+    std::vector<std::uint32_t> invalid = {0, 1000};
+    EXPECT_THROW(decode(dictionary, invalid.begin(), invalid.end(), copies.begin()), std::out_of_range);
+}
+
+TEST(Dictionary, id_space) {
+    using namespace bimap;
+    bidirectional_map<std::string, std::uint8_t> dictionary = {{"a", 0}};
+    std::vector<std::string> column;
+    for (int i = 0; i < 255; ++i) {
+        column.emplace_back("v" + std::to_string(i));
+    }
+
+    std::vector<std::uint8_t> ids(column.size());
+    EXPECT_EQ(encode(dictionary, column.begin(), column.end(), ids.begin()), 255);
+    EXPECT_EQ(ids[0], 1);
+    EXPECT_EQ(ids[254], 255);
+    EXPECT_EQ(dictionary.size(), 256);
+    std::vector<std::string_view> more = {"a", "new"};
+    EXPECT_THROW(encode(dictionary, more.begin(), more.end(), ids.begin()), std::overflow_error);
+    EXPECT_EQ(dictionary.size(), 256);
+    EXPECT_EQ(dictionary.erase("v254"), 1);
+    // only one id is free, nothing is inserted
+    std::vector<std::string_view> two = {"x", "a", "y"};
+    EXPECT_THROW(encode(dictionary, two.begin(), two.end(), ids.begin()), std::overflow_error);
+    EXPECT_EQ(dictionary.size(), 255);
+    EXPECT_FALSE(dictionary.contains("x"));
+    EXPECT_EQ(encode(dictionary, two.begin(), two.begin() + 2, ids.begin()), 1);
+    EXPECT_EQ(dictionary.at("x"), 255);
+}
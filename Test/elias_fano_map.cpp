@@ -0,0 +1,105 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <unordered_set>
+#include <numeric>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <cstdint>
+
+#include "elias_fano_map.hpp"
+
+TEST(EliasFanoMap, packed_vector) {
+    using namespace bimap::impl;
+    for (unsigned width : {1u, 7u, 33u, 64u}) {
+        packed_vector vec(100, width);
+        const auto mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+        for (std::size_t i = 0; i < 100; ++i) {
+            vec.set(i, (i * 0x9e3779b97f4a7c15ull) & mask);
+        }
+
+        for (std::size_t i = 0; i < 100; ++i) {
+            ASSERT_EQ(vec.get(i), (i * 0x9e3779b97f4a7c15ull) & mask);
+        }
+    }
+}
+
+TEST(EliasFanoMap, lookup) {
+    using namespace bimap;
+    std::mt19937_64 gen(17);
+    for (std::uint64_t maxKey : {std::uint64_t(20000), std::uint64_t(1) << 40,
+                                 std::numeric_limits<std::uint64_t>::max()}) {
+        std::uniform_int_distribution<std::uint64_t> dist(0, maxKey);
+        std::unordered_set<std::uint64_t> unique;
+        std::vector<std::uint64_t> keys;
+        while (keys.size() < 10000) {
+            auto key = dist(gen);
+            if (unique.emplace(key).second) {
+                keys.emplace_back(key);
+            }
+        }
+
+        elias_fano_map<> map(keys.begin(), keys.end());
+        EXPECT_EQ(map.size(), keys.size());
+        for (std::uint32_t row = 0; row < keys.size(); ++row) {
+            ASSERT_EQ(map.find(keys[row]), row);
+            ASSERT_EQ(map.inverse().at(row), keys[row]);
+        }
+
+        for (int i = 0; i < 10000; ++i) {
+            auto key = dist(gen);
+            EXPECT_EQ(map.contains(key), unique.count(key) == 1);
+        }
+
+        std::uint64_t previous = 0;
+        std::size_t count = 0;
+        for (auto [key, row] : map) {
+            EXPECT_TRUE(count == 0 || previous < key);
+            EXPECT_EQ(keys[row], key);
+            previous = key;
+            ++count;
+        }
+
+        EXPECT_EQ(count, keys.size());
+        EXPECT_THROW(map.inverse().at(10000), std::out_of_range);
+        EXPECT_FALSE(map.inverse().find(10000).has_value());
+    }
+}
+
+TEST(EliasFanoMap, edge_cases) {
+    using namespace bimap;
+    elias_fano_map<> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.contains(0));
+    std::vector<std::uint64_t> keys{5, 0, std::numeric_limits<std::uint64_t>::max(), 6};
+    elias_fano_map<> map(keys.begin(), keys.end());
+    EXPECT_EQ(map.at(0), 1);
+    EXPECT_EQ(map.at(5), 0);
+    EXPECT_EQ(map.at(std::numeric_limits<std::uint64_t>::max()), 2);
+    EXPECT_EQ(map.inverse().at(3), 6);
+    EXPECT_FALSE(map.contains(4));
+    EXPECT_THROW(map.at(7), std::out_of_range);
+    std::vector<std::uint64_t> duplicates{1, 2, 1};
+    EXPECT_THROW(elias_fano_map<>(duplicates.begin(), duplicates.end()), std::invalid_argument);
+    std::vector<std::uint64_t> many(300);
+    std::iota(many.begin(), many.end(), 0);
+    EXPECT_THROW(elias_fano_map<std::uint8_t>(many.begin(), many.end()), std::invalid_argument);
+    EXPECT_LT(map.encoded_size(), 200);
+}
+
+TEST(EliasFanoMap, compression) {
+    using namespace bimap;
+    std::vector<std::uint64_t> keys;
+    std::mt19937_64 gen(1);
+    for (std::uint64_t i = 0; i < 100000; ++i) {
+        keys.emplace_back((i << 20) | (gen() & 0xfffff));
+    }
+
+    std::shuffle(keys.begin(), keys.end(), gen);
+    elias_fano_map<> map(keys.begin(), keys.end());
+    EXPECT_LT(map.encoded_size(), keys.size() * 10);
+    EXPECT_EQ(map.inverse().at(123), keys[123]);
+}
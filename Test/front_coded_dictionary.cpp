@@ -0,0 +1,75 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <random>
+
+#include "front_coded_dictionary.hpp"
+
+TEST(FrontCodedDictionary, lookup) {
+    using namespace bimap;
+    std::set<std::string> words;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> letter('a', 'e');
+    std::uniform_int_distribution<std::size_t> length(0, 12);
+    while (words.size() < 5000) {
+        std::string word(length(gen), ' ');
+        for (auto &c : word) {
+            c = static_cast<char>(letter(gen));
+        }
+
+        words.emplace(std::move(word));
+    }
+
+    for (std::size_t blockSize : {1, 7, 16}) {
+        front_coded_dictionary<> dict(words.begin(), words.end(), blockSize);
+        EXPECT_EQ(dict.size(), words.size());
+        std::size_t id = 0;
+        for (const auto &word : words) {
+            ASSERT_EQ(dict.find(word), id);
+            EXPECT_EQ(dict.inverse().at(static_cast<std::uint32_t>(id)), word);
+            ++id;
+        }
+
+        id = 0;
+        auto word = words.begin();
+        for (auto [i, str] : dict) {
+            EXPECT_EQ(i, id++);
+            EXPECT_EQ(str, *word++);
+        }
+
+        EXPECT_EQ(id, words.size());
+        EXPECT_FALSE(dict.contains("f"));
+        EXPECT_FALSE(dict.contains("aaaaaaaaaaaaaaa"));
+        EXPECT_THROW(dict.at("zzz"), std::out_of_range);
+        EXPECT_FALSE(dict.inverse().find(5000).has_value());
+        EXPECT_THROW(dict.inverse().at(5000), std::out_of_range);
+    }
+}
+
+TEST(FrontCodedDictionary, construction) {
+    using namespace bimap;
+    std::vector<std::string> words{"apple", "apply", "banana"};
+    front_coded_dictionary<> dict(words.begin(), words.end());
+    EXPECT_EQ(dict.at("apply"), 1);
+    EXPECT_EQ(dict.inverse().at(2), "banana");
+    EXPECT_EQ(dict.inverse().inverse().at("apple"), 0);
+    EXPECT_FALSE(dict.contains("a"));
+    EXPECT_FALSE(dict.contains("appl"));
+    EXPECT_TRUE(front_coded_dictionary<>().empty());
+    EXPECT_EQ(front_coded_dictionary<>().find(""), npos);
+    std::vector<std::string> unsorted{"b", "a"};
+    EXPECT_THROW(front_coded_dictionary<>(unsorted.begin(), unsorted.end()), std::invalid_argument);
+    std::vector<std::string> duplicates{"a", "a"};
+    EXPECT_THROW(front_coded_dictionary<>(duplicates.begin(), duplicates.end()), std::invalid_argument);
+    EXPECT_THROW(front_coded_dictionary<>(words.begin(), words.end(), 0), std::invalid_argument);
+    std::vector<std::string> many(300);
+    for (std::size_t i = 0; i < many.size(); ++i) {
+        many[i] = std::to_string(1000 + i);
+    }
+
+    EXPECT_THROW(front_coded_dictionary<std::uint8_t>(many.begin(), many.end()), std::invalid_argument);
+}
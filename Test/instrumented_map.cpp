@@ -0,0 +1,87 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+
+#include "bidirectional_map.hpp"
+#include "instrumented_map.hpp"
+
+TEST(InstrumentedMap, conflicts_and_lookups) {
+    using namespace bimap;
+    bidirectional_map<std::string, int, instrumented<std::unordered_map>::type, instrumented<std::map>::type> map;
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(map.emplace(std::to_string(i), i).second);
+    }
+
+    EXPECT_FALSE(map.emplace("1", 5000).second);
+    EXPECT_FALSE(map.emplace("x", 1).second);
+    EXPECT_FALSE(map.emplace("y", 2).second);
+    EXPECT_FALSE(map.inverse().emplace(3, "x").second);
+    auto forward = map.statistics();
+    EXPECT_EQ(forward.insertions, 1000);
+    EXPECT_EQ(forward.forward_conflicts, 1);
+    EXPECT_EQ(forward.inverse_conflicts, 2);
+    EXPECT_GE(forward.lookups, 1000);
+    EXPECT_GT(forward.rehashes, 0);
+    EXPECT_GT(forward.bucket_count, 0);
+    EXPECT_NEAR(forward.load_factor, 1000.0 / static_cast<double>(forward.bucket_count), 1e-9);
+    EXPECT_EQ(std::accumulate(forward.bucket_occupancy.begin(), forward.bucket_occupancy.end(), std::size_t(0)),
+              forward.bucket_count);
+    EXPECT_GE(forward.max_probe_length, 1);
+    EXPECT_GT(forward.average_probe_length(), 0);
+    EXPECT_LE(forward.average_probe_length(), static_cast<double>(forward.max_probe_length));
+
+    auto inverse = map.inverse().statistics();
+    EXPECT_EQ(inverse.insertions, 1000);
+    EXPECT_EQ(inverse.forward_conflicts, 1);
+    EXPECT_EQ(inverse.inverse_conflicts, 0);
+    EXPECT_EQ(inverse.bucket_count, 0);
+    EXPECT_EQ(inverse.probes, 0);
+    EXPECT_EQ(inverse.rehashes, 0);
+    EXPECT_EQ(map.inverse().lower_bound(500)->first, 500);
+
+    map.reset_statistics();
+    EXPECT_EQ(map.statistics().lookups, 0);
+    EXPECT_EQ(map.statistics().insertions, 0);
+    EXPECT_EQ(map.inverse().statistics().insertions, 1000);
+    map.erase("17");
+    EXPECT_EQ(map.size(), 999);
+    EXPECT_FALSE(map.inverse().contains(17));
+}
+
+TEST(InstrumentedMap, multimap_fan_out) {
+    using namespace bimap;
+    bidirectional_map<int, int, instrumented<std::unordered_multimap>::type, instrumented<std::unordered_map>::type>
+            map;
+    for (int i = 0; i < 100; ++i) {
+        map.emplace(i % 7 == 0 ? 0 : i, i);
+    }
+
+    EXPECT_EQ(map.statistics().max_fan_out, 15);
+    EXPECT_EQ(map.statistics().forward_conflicts, 0);
+    EXPECT_EQ(map.inverse().statistics().max_fan_out, 0);
+    auto copy = map;
+    EXPECT_EQ(copy, map);
+}
+
+TEST(InstrumentedMap, reserve_and_swap) {
+    using namespace bimap;
+    instrumented_map<std::unordered_map<int, int>> test, other;
+    test.reserve(10000);
+    EXPECT_EQ(test.statistics().rehashes, 1);
+    for (int i = 0; i < 10000; ++i) {
+        test.emplace(i, i);
+    }
+
+    EXPECT_EQ(test.statistics().rehashes, 1);
+    swap(test, other);
+    EXPECT_TRUE(test.empty());
+    EXPECT_EQ(test.statistics().insertions, 0);
+    EXPECT_EQ(other.statistics().insertions, 10000);
+    EXPECT_EQ(other.find(17)->second, 17);
+    EXPECT_EQ(other.statistics().lookups, 1);
+}
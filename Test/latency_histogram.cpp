@@ -0,0 +1,139 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <map>
+#include <execution>
+
+#include "bidirectional_map.hpp"
+#include "latency_histogram.hpp"
+#include "algorithms.hpp"
+#include "dictionary.hpp"
+
+TEST(LatencyHistogram, buckets) {
+    using namespace bimap;
+    for (std::uint64_t value : std::initializer_list<std::uint64_t>{0, 1, 63, 64, 65, 1000, 123456789, 1ull << 40,
+                                std::numeric_limits<std::uint64_t>::max()}) {
+        const auto index = latency_histogram::index_of(value);
+        ASSERT_LT(index, latency_histogram::bucket_count);
+        EXPECT_GE(latency_histogram::upper_bound_of(index), value);
+        if (index > 0) {
+            EXPECT_LT(latency_histogram::upper_bound_of(index - 1), value);
+        }
+
+        const auto width = latency_histogram::upper_bound_of(index) - (index == 0 ? 0 :
+                latency_histogram::upper_bound_of(index - 1));
+        EXPECT_LE(width, std::max<std::uint64_t>(1, value / latency_histogram::sub_buckets));
+    }
+}
+
+TEST(LatencyHistogram, quantiles) {
+    using namespace bimap;
+    latency_histogram hist;
+    EXPECT_EQ(hist.value_at(0.5), 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&hist] {
+            for (std::uint64_t i = 1; i <= 1000; ++i) {
+                hist.record(i);
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(hist.count(), 4000);
+    EXPECT_EQ(hist.max(), 1000);
+    EXPECT_NEAR(static_cast<double>(hist.value_at(0.5)), 500, 500.0 / latency_histogram::sub_buckets);
+    EXPECT_NEAR(static_cast<double>(hist.value_at(0.99)), 990, 990.0 / latency_histogram::sub_buckets);
+    EXPECT_EQ(hist.value_at(1), 1000);
+    hist.reset();
+    EXPECT_EQ(hist.count(), 0);
+    EXPECT_EQ(hist.max(), 0);
+}
+
+TEST(LatencyHistogram, bidirectional_map_policy) {
+    using namespace bimap;
+    struct Tag {};
+    using Policy = latency_histogram_policy<Tag>;
+    bidirectional_map<std::string, int, std::unordered_map, std::unordered_map, Policy> map;
+    for (int i = 0; i < 100; ++i) {
+        map.emplace(std::to_string(i), i);
+    }
+
+    map.emplace("x", 5);
+    EXPECT_EQ(map.inverse().find(17)->second, "17");
+    EXPECT_TRUE(map.contains("3"));
+    map.erase("4");
+    map.inverse().erase(5);
+    EXPECT_EQ(Policy::histogram(map_operation::emplace, false).count(), 101);
+    EXPECT_EQ(Policy::histogram(map_operation::emplace, true).count(), 0);
+    EXPECT_EQ(Policy::histogram(map_operation::find, false).count(), 1);
+    EXPECT_EQ(Policy::histogram(map_operation::find, true).count(), 1);
+    EXPECT_EQ(Policy::histogram(map_operation::erase, false).count(), 1);
+    EXPECT_EQ(Policy::histogram(map_operation::erase, true).count(), 1);
+    EXPECT_GT(Policy::histogram(map_operation::emplace, false).max(), 0);
+
+    std::ostringstream out;
+    Policy::write_text(out);
+    EXPECT_NE(out.str().find("emplace forward count=101 "), std::string::npos);
+    EXPECT_NE(out.str().find("find inverse count=1 "), std::string::npos);
+    Policy::reset();
+    EXPECT_EQ(Policy::histogram(map_operation::emplace, false).count(), 0);
+
+    auto copy = map;
+    swap(copy, map);
+    EXPECT_EQ(map.size(), 98);
+    EXPECT_EQ(sizeof(bidirectional_map<int, int>), (sizeof(bidirectional_map<int, int, std::unordered_map,
+            std::unordered_map, Policy>)));
+}
+
+TEST(LatencyHistogram, erase_records_one_sample_per_call) {
+    using namespace bimap;
+    struct Tag {};
+    using Policy = latency_histogram_policy<Tag>;
+    bidirectional_map<int, int, std::multimap, std::map, Policy> map;
+    for (int i = 0; i < 10; ++i) {
+        map.emplace(i % 2, i);
+    }
+
+    EXPECT_EQ(map.erase(0), 5);
+    EXPECT_EQ(Policy::histogram(map_operation::erase, false).count(), 1);
+    map.erase(map.begin(), map.end());
+    EXPECT_EQ(Policy::histogram(map_operation::erase, false).count(), 2);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(LatencyHistogram, algorithms_with_policy) {
+    using namespace bimap;
+    struct Tag {};
+    using Policy = latency_histogram_policy<Tag>;
+    using Map = bidirectional_map<int, int, std::unordered_map, std::unordered_map, Policy>;
+    Map lhs, rhs;
+    for (int i = 0; i < 100; ++i) {
+        lhs.emplace(i, i * 2);
+        rhs.emplace(i + 50, i * 2 + 100);
+    }
+
+    EXPECT_EQ(count_if(std::execution::seq, lhs, [](int key, int) { return key % 2 == 0; }), 50);
+    auto result = merge_union(lhs, rhs);
+    static_assert(std::is_same_v<decltype(result.map), Map>);
+    EXPECT_EQ(result.map.size(), 150);
+    auto composed = compose(lhs, lhs);
+    static_assert(std::is_same_v<decltype(composed), Map>);
+    EXPECT_EQ(diff(lhs, lhs).insertions.size(), 0);
+
+    bidirectional_map<std::string, std::uint32_t, std::unordered_map, std::unordered_map, Policy> dictionary;
+    const std::vector<std::string> column = {"a", "b", "a", "c"};
+    std::vector<std::uint32_t> ids(column.size());
+    EXPECT_EQ(encode(dictionary, column.begin(), column.end(), ids.begin()), 3);
+    EXPECT_EQ(ids[0], ids[2]);
+    EXPECT_GT(Policy::histogram(map_operation::emplace, false).count(), 0);
+}
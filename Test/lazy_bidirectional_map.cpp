@@ -0,0 +1,172 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <random>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "lazy_bidirectional_map.hpp"
+
+template<template<typename ...> typename ForwardMap, template<typename ...> typename InverseMap>
+void testLazySync() {
+    using namespace bimap;
+    lazy_bidirectional_map<std::string, int, ForwardMap, InverseMap> map;
+    EXPECT_TRUE(map.emplace("a", 1).second);
+    EXPECT_TRUE(map.emplace("b", 2).second);
+    EXPECT_FALSE(map.emplace("a", 3).second);
+    EXPECT_TRUE(map.emplace("c", 1).second);
+    EXPECT_TRUE(map.emplace("d", 4).second);
+    EXPECT_FALSE(map.synced());
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.at("c"), 1);
+    EXPECT_EQ(map.erase("d"), 1);
+    EXPECT_THROW(std::as_const(map).inverse(), std::logic_error);
+    auto copy = map;
+    auto rejected = map.sync();
+    EXPECT_TRUE(map.synced());
+    EXPECT_EQ(rejected, (std::vector<std::pair<std::string, int>>{{"c", 1}}));
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_FALSE(map.contains("c"));
+    EXPECT_EQ(std::as_const(map).inverse().at(1), "a");
+    EXPECT_EQ(map.inverse().find(2)->second, "b");
+    EXPECT_FALSE(map.inverse().contains(4));
+    EXPECT_EQ(map.erase("a"), 1);
+    EXPECT_FALSE(map.inverse().contains(1));
+    EXPECT_TRUE(map.emplace("c", 1).second);
+    EXPECT_EQ(map.inverse().at(1), "c");
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(copy.inverse().at(1), "a");
+    EXPECT_EQ(copy.size(), 2);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.inverse().empty());
+}
+
+TEST(LazyBidirectionalMap, sync) {
+    testLazySync<std::unordered_map, std::unordered_map>();
+    testLazySync<std::map, std::map>();
+}
+
+struct ThrowingCopy {
+    static inline int copiesUntilThrow = -1;
+    int value;
+
+    ThrowingCopy(int value) noexcept: value(value) {}
+
+    ThrowingCopy(const ThrowingCopy &other) : value(other.value) {
+        if (copiesUntilThrow >= 0 && copiesUntilThrow-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+
+    bool operator<(const ThrowingCopy &other) const noexcept {
+        return value < other.value;
+    }
+};
+
+TEST(LazyBidirectionalMap, throwing_sync) {
+    using namespace bimap;
+    lazy_bidirectional_map<int, ThrowingCopy, std::unordered_map, std::map> map;
+    map.emplace(1, 10);
+    map.emplace(2, 20);
+    map.emplace(3, 20);
+    map.emplace(4, 40);
+    // the copy of the fourth inverse key throws, the third pair was rejected before
+    ThrowingCopy::copiesUntilThrow = 3;
+    EXPECT_THROW(map.sync(), std::runtime_error);
+    ThrowingCopy::copiesUntilThrow = -1;
+    EXPECT_FALSE(map.synced());
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_TRUE(map.sync().empty());
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.inverse().at(10), 1);
+    EXPECT_EQ(map.inverse().at(20), 2);
+    EXPECT_EQ(map.inverse().at(40), 4);
+    EXPECT_EQ(map.erase(4), 1);
+    EXPECT_FALSE(map.inverse().contains(40));
+}
+
+TEST(LazyBidirectionalMap, erase_keeps_insertion_order) {
+    using namespace bimap;
+    lazy_bidirectional_map<std::string, int> map;
+    map.emplace("x", 9);
+    map.emplace("a", 1);
+    map.emplace("c", 1);
+    EXPECT_EQ(map.erase("x"), 1);
+    auto rejected = map.sync();
+    EXPECT_EQ(rejected, (std::vector<std::pair<std::string, int>>{{"c", 1}}));
+    EXPECT_EQ(map.inverse().at(1), "a");
+}
+
+TEST(LazyBidirectionalMap, random_operations) {
+    using namespace bimap;
+    lazy_bidirectional_map<int, int> map;
+    // model: synced pairs and pending pairs in insertion order
+    std::unordered_map<int, int> forward;
+    std::unordered_map<int, int> inverse;
+    std::vector<std::pair<int, int>> pending;
+    auto syncModel = [&]() {
+        std::vector<std::pair<int, int>> rejected;
+        for (auto [key, value] : pending) {
+            if (inverse.emplace(value, key).second) {
+                forward.emplace(key, value);
+            } else {
+                rejected.emplace_back(key, value);
+            }
+        }
+
+        pending.clear();
+        return rejected;
+    };
+
+    std::mt19937 gen(12);
+    std::uniform_int_distribution<int> dist(0, 500);
+    for (int i = 0; i < 20000; ++i) {
+        const auto key = dist(gen), value = dist(gen);
+        const auto op = gen() % 16;
+        if (op < 8) {
+            const bool contained = forward.count(key) == 1 ||
+                                   std::any_of(pending.begin(), pending.end(), [key](auto item) {
+                                       return item.first == key;
+                                   });
+            EXPECT_EQ(map.emplace(key, value).second, !contained);
+            if (!contained) {
+                pending.emplace_back(key, value);
+            }
+        } else if (op < 14) {
+            auto pos = std::find_if(pending.begin(), pending.end(), [key](auto item) { return item.first == key; });
+            std::size_t expected = 0;
+            if (pos != pending.end()) {
+                pending.erase(pos);
+                expected = 1;
+            } else if (auto it = forward.find(key); it != forward.end()) {
+                inverse.erase(it->second);
+                forward.erase(it);
+                expected = 1;
+            }
+
+            EXPECT_EQ(map.erase(key), expected);
+        } else if (op == 14) {
+            EXPECT_EQ(map.sync(), syncModel());
+        } else {
+            syncModel();
+            EXPECT_EQ(map.inverse().contains(value), inverse.count(value) == 1);
+        }
+
+        EXPECT_EQ(map.size(), forward.size() + pending.size());
+    }
+
+    EXPECT_EQ(map.sync(), syncModel());
+    EXPECT_EQ(map.size(), forward.size());
+    for (auto [value, key] : map.inverse()) {
+        EXPECT_EQ(inverse.at(value), key);
+        EXPECT_EQ(map.at(key), value);
+    }
+}
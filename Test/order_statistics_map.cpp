@@ -0,0 +1,86 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <random>
+
+#include "bidirectional_map.hpp"
+#include "order_statistics_map.hpp"
+
+TEST(OrderStatisticsMap, matches_std_map) {
+    using namespace bimap;
+    order_statistics_map<int, int> test;
+    std::map<int, int> reference;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 500);
+    for (int i = 0; i < 2000; ++i) {
+        auto key = dist(gen);
+        if (i % 3 == 0) {
+            EXPECT_EQ(test.erase(key), reference.erase(key));
+        } else {
+            auto [it, inserted] = test.emplace(key, i);
+            auto [refIt, refInserted] = reference.emplace(key, i);
+            EXPECT_EQ(inserted, refInserted);
+            EXPECT_EQ(it->second, refIt->second);
+        }
+    }
+
+    ASSERT_EQ(test.size(), reference.size());
+    EXPECT_TRUE(std::equal(test.begin(), test.end(), reference.begin()));
+    std::size_t index = 0;
+    for (const auto &[key, val] : reference) {
+        EXPECT_EQ(test.rank(key), index);
+        EXPECT_EQ(test.select(index)->first, key);
+        ++index;
+    }
+
+    EXPECT_EQ(test.select(test.size()), test.end());
+    EXPECT_EQ(test.count_range(100, 200), std::distance(reference.lower_bound(100), reference.lower_bound(200)));
+    EXPECT_EQ(test.count_range(200, 100), 0);
+    auto last = test.end();
+    --last;
+    EXPECT_EQ(last->first, reference.rbegin()->first);
+}
+
+TEST(OrderStatisticsMap, copy_and_move) {
+    using namespace bimap;
+    order_statistics_map<std::string, int> original;
+    original.emplace("b", 2);
+    original.emplace("a", 1);
+    original.emplace("c", 3);
+    auto copy = original;
+    EXPECT_EQ(copy, original);
+    copy.erase("a");
+    EXPECT_NE(copy, original);
+    EXPECT_EQ(original.rank("c"), 2);
+    EXPECT_EQ(copy.rank("c"), 1);
+    auto moved = std::move(original);
+    EXPECT_TRUE(original.empty());
+    EXPECT_EQ(moved.size(), 3);
+    EXPECT_EQ(moved.select(0)->first, "a");
+}
+
+TEST(OrderStatisticsMap, bidirectional_map_base) {
+    using namespace bimap;
+    bidirectional_map<std::string, int, order_statistics_map, order_statistics_map> test =
+            {{"d", 40}, {"a", 10}, {"c", 30}, {"b", 20}, {"e", 50}};
+    EXPECT_EQ(test.rank("c"), 2);
+    EXPECT_EQ(test.rank("bb"), 2);
+    EXPECT_EQ(test.select(3)->first, "d");
+    EXPECT_EQ(test.select(3)->second, 40);
+    EXPECT_EQ(test.select(5), test.end());
+    EXPECT_EQ(test.count_range("b", "e"), 3);
+    EXPECT_EQ(test.inverse().rank(35), 3);
+    EXPECT_EQ(test.inverse().select(0)->second, "a");
+    EXPECT_EQ(test.inverse().count_range(0, 100), 5);
+    test.erase("b");
+    test.inverse().erase(50);
+    EXPECT_EQ(test.rank("c"), 1);
+    EXPECT_EQ(test.inverse().rank(40), 2);
+    EXPECT_EQ(test.at("d"), 40);
+    EXPECT_EQ(test.inverse().at(30), "c");
+    auto copy = test;
+    EXPECT_EQ(copy, test);
+}
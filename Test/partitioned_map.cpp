@@ -0,0 +1,83 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <atomic>
+#include <random>
+#include <mutex>
+#include <set>
+
+#include "bidirectional_map.hpp"
+#include "partitioned_map.hpp"
+
+TEST(PartitionedMap, split_and_merge) {
+    using namespace bimap;
+    partitioned_map<int, int> test;
+    std::map<int, int> reference;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> dist(0, 20000);
+    for (int i = 0; i < 15000; ++i) {
+        auto key = dist(gen);
+        auto [pos, inserted] = test.emplace(key, i);
+        EXPECT_EQ(inserted, reference.emplace(key, i).second);
+        // also when the insertion split the partition
+        EXPECT_EQ(pos->first, key);
+    }
+
+    EXPECT_GT(test.partition_count(), 4);
+    ASSERT_EQ(test.size(), reference.size());
+    EXPECT_TRUE(std::equal(test.begin(), test.end(), reference.begin()));
+    auto it = test.lower_bound(10000);
+    auto refIt = reference.lower_bound(10000);
+    while (it != test.end()) {
+        ASSERT_EQ(it->first, refIt->first);
+        it = test.erase(it);
+        refIt = reference.erase(refIt);
+    }
+
+    ASSERT_EQ(test.size(), reference.size());
+    EXPECT_TRUE(std::equal(test.begin(), test.end(), reference.begin()));
+    auto last = test.end();
+    EXPECT_EQ((--last)->first, reference.rbegin()->first);
+    test.clear();
+    EXPECT_EQ(test.partition_count(), 1);
+    EXPECT_EQ(test.begin(), test.end());
+}
+
+TEST(PartitionedMap, parallel_range_for_each) {
+    using namespace bimap;
+    bidirectional_map<int, int, partitioned_map, partitioned_map> test;
+    for (int i = 0; i < 10000; ++i) {
+        test.emplace(i, 3 * i);
+    }
+
+    std::atomic<long> sum{0};
+    std::atomic<int> count{0};
+    test.parallel_range_for_each(1000, 9000, [&](int key, int value) {
+        EXPECT_EQ(value, 3 * key);
+        sum += key;
+        ++count;
+    });
+    EXPECT_EQ(count, 8000);
+    EXPECT_EQ(sum, (1000L + 8999L) * 8000L / 2);
+    count = 0;
+    test.inverse().parallel_range_for_each(0, 300, [&](int, int) { ++count; });
+    EXPECT_EQ(count, 100);
+    std::mutex mutex;
+    std::set<int> visited;
+    test.inverse().parallel_for_each([&](int key, int value) {
+        EXPECT_EQ(key, 3 * value);
+        std::lock_guard lock(mutex);
+        visited.emplace(value);
+    });
+    EXPECT_EQ(visited.size(), 10000);
+    test.erase(test.lower_bound(10), test.lower_bound(9990));
+    test.emplace(-1, -1);
+    EXPECT_EQ(test.size(), 21);
+    EXPECT_EQ(test.inverse().size(), 21);
+    EXPECT_EQ(test.inverse().find(-1)->second, -1);
+    EXPECT_EQ(test.inverse().at(29997), 9999);
+    EXPECT_FALSE(test.inverse().contains(30));
+}
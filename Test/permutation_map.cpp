@@ -0,0 +1,66 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#include "permutation_map.hpp"
+
+TEST(PermutationMap, lookup) {
+    using namespace bimap;
+    permutation_map<> test(std::vector<std::uint32_t>{2, 0, 3, 1});
+    EXPECT_EQ(test.size(), 4);
+    EXPECT_EQ(test.at(0), 2);
+    EXPECT_EQ(test.inverse().at(2), 0);
+    EXPECT_EQ(test.inverse().inverse().at(3), 1);
+    EXPECT_EQ(test.find(3)->second, 1);
+    EXPECT_EQ(test.find(4), test.end());
+    EXPECT_FALSE(test.contains(4));
+    EXPECT_THROW(test.at(4), std::out_of_range);
+    EXPECT_THROW(permutation_map<>(std::vector<std::uint32_t>{0, 0}), std::invalid_argument);
+    EXPECT_THROW(permutation_map<>(std::vector<std::uint32_t>{0, 2}), std::invalid_argument);
+    EXPECT_THROW(permutation_map<int>(std::vector<int>{-1, 0}), std::invalid_argument);
+    EXPECT_FALSE(permutation_map<int>(2).contains(-1));
+    EXPECT_THROW(permutation_map<std::uint8_t>(257), std::length_error);
+    EXPECT_THROW(permutation_map<std::int8_t>(std::vector<std::int8_t>(129)), std::length_error);
+    EXPECT_EQ(permutation_map<std::uint8_t>(256).inverse().at(255), 255);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> items(test.begin(), test.end());
+    EXPECT_EQ(items, (std::vector<std::pair<std::uint32_t, std::uint32_t>>{{0, 2}, {1, 0}, {2, 3}, {3, 1}}));
+    EXPECT_EQ(test.end() - test.begin(), 4);
+    EXPECT_EQ(test.begin()[2].second, 3);
+}
+
+TEST(PermutationMap, swap_images) {
+    using namespace bimap;
+    std::mt19937 gen(5);
+    std::vector<std::uint32_t> reference(1000);
+    std::iota(reference.begin(), reference.end(), 0);
+    permutation_map<> test(reference.size());
+    std::uniform_int_distribution<std::uint32_t> dist(0, 999);
+    for (int i = 0; i < 5000; ++i) {
+        auto lhs = dist(gen), rhs = dist(gen);
+        if (i % 2 == 0) {
+            test.swap_images(lhs, rhs);
+            std::swap(reference[lhs], reference[rhs]);
+        } else {
+            test.swap_preimages(lhs, rhs);
+            auto l = std::find(reference.begin(), reference.end(), lhs);
+            auto r = std::find(reference.begin(), reference.end(), rhs);
+            std::iter_swap(l, r);
+        }
+    }
+
+    EXPECT_EQ(test, permutation_map<>(reference));
+    for (auto [pos, image] : test) {
+        EXPECT_EQ(test.inverse().at(image), pos);
+    }
+
+    auto copy = test;
+    permutation_map<> other;
+    other.swap(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(other.inverse(), test.inverse());
+}
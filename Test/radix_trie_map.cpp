@@ -0,0 +1,98 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <map>
+#include <vector>
+#include <random>
+
+#include "bidirectional_map.hpp"
+#include "radix_trie_map.hpp"
+
+TEST(RadixTrieMap, matches_std_map) {
+    using namespace bimap;
+    radix_trie_map<std::string, int> test;
+    std::map<std::string, int> reference;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> length(0, 6);
+    std::uniform_int_distribution<int> character('a', 'c');
+    auto randomKey = [&]() {
+        std::string ret(static_cast<std::size_t>(length(gen)), 'a');
+        for (auto &c : ret) {
+            c = static_cast<char>(character(gen));
+        }
+
+        return ret;
+    };
+
+    for (int i = 0; i < 3000; ++i) {
+        auto key = randomKey();
+        if (i % 3 == 0) {
+            EXPECT_EQ(test.erase(key), reference.erase(key));
+        } else {
+            EXPECT_EQ(test.emplace(key, i).second, reference.emplace(key, i).second);
+        }
+
+        if (i % 100 == 0) {
+            auto probe = randomKey();
+            auto lb = test.lower_bound(probe);
+            auto refLb = reference.lower_bound(probe);
+            EXPECT_EQ(lb == test.end(), refLb == reference.end());
+            if (refLb != reference.end() && lb != test.end()) {
+                EXPECT_EQ(lb->first, refLb->first);
+            }
+
+            auto [first, last] = test.prefix_range(probe);
+            std::vector<std::string> found, expected;
+            for (; first != last; ++first) {
+                found.emplace_back(first->first);
+            }
+
+            for (auto it = reference.lower_bound(probe); it != reference.end() && it->first.rfind(probe, 0) == 0;
+                 ++it) {
+                expected.emplace_back(it->first);
+            }
+
+            EXPECT_EQ(found, expected);
+        }
+    }
+
+    ASSERT_EQ(test.size(), reference.size());
+    EXPECT_TRUE(std::equal(test.begin(), test.end(), reference.begin()));
+    std::vector<std::string> backwards;
+    for (auto it = test.end(); it != test.begin();) {
+        backwards.emplace_back((--it)->first);
+    }
+
+    EXPECT_TRUE(std::equal(backwards.begin(), backwards.end(), reference.rbegin(),
+                           [](const auto &key, const auto &item) { return key == item.first; }));
+}
+
+TEST(RadixTrieMap, prefix_range) {
+    using namespace bimap;
+    bidirectional_map<std::string, int, radix_trie_map> test = {{"eu/db/1", 1}, {"eu/db/2", 2}, {"eu/web/1", 3},
+                                                                {"us/db/1", 4}, {"eu", 5}};
+    auto [first, last] = test.prefix_range("eu/d");
+    std::vector<int> ids;
+    for (; first != last; ++first) {
+        ids.emplace_back(first->second);
+    }
+
+    EXPECT_EQ(ids, (std::vector<int>{1, 2}));
+    std::tie(first, last) = test.prefix_range("eu");
+    EXPECT_EQ(std::distance(first, last), 4);
+    std::tie(first, last) = test.prefix_range("ap");
+    EXPECT_EQ(first, last);
+    std::tie(first, last) = test.prefix_range("");
+    EXPECT_EQ(std::distance(first, last), 5);
+    EXPECT_EQ(test.inverse().at(3), "eu/web/1");
+    test.erase("eu/db/1");
+    test.inverse().erase(5);
+    EXPECT_EQ(test.at("eu/db/2"), 2);
+    EXPECT_EQ(test.inverse().at(2), "eu/db/2");
+    std::tie(first, last) = test.prefix_range("eu");
+    EXPECT_EQ(std::distance(first, last), 2);
+    auto copy = test;
+    EXPECT_EQ(copy, test);
+}
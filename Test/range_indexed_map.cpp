@@ -0,0 +1,113 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <set>
+#include <random>
+#include <unordered_map>
+#include <stdexcept>
+
+#include "bidirectional_map.hpp"
+#include "range_indexed_map.hpp"
+
+TEST(RangeIndexedMap, matches_brute_force) {
+    using namespace bimap;
+    bidirectional_map<int, int, range_indexed_map> test;
+    std::unordered_map<int, int> reference;
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<int> dist(0, 1000);
+    for (int round = 0; round < 30; ++round) {
+        for (int i = 0; i < 100; ++i) {
+            auto key = dist(gen);
+            if (i % 4 == 0) {
+                reference.erase(key);
+                test.erase(key);
+            } else if (test.emplace(key, dist(gen)).second) {
+                reference.emplace(key, test.at(key));
+            }
+        }
+
+        int lo1 = dist(gen), lo2 = dist(gen);
+        int hi1 = lo1 + 300, hi2 = lo2 + 300;
+        std::set<std::pair<int, int>> expected, actual;
+        for (const auto &[k1, k2] : reference) {
+            if (k1 >= lo1 && k1 <= hi1 && k2 >= lo2 && k2 <= hi2) {
+                expected.emplace(k1, k2);
+            }
+        }
+
+        test.range_query(lo1, hi1, lo2, hi2, [&actual](int k1, int k2) {
+            EXPECT_TRUE(actual.emplace(k1, k2).second);
+        });
+        EXPECT_EQ(actual, expected);
+        EXPECT_EQ(test.range_count(lo1, hi1, lo2, hi2), expected.size());
+    }
+}
+
+TEST(RangeIndexedMap, inverse_access) {
+    using namespace bimap;
+    bidirectional_map<std::string, int, range_indexed_map, range_indexed_map> test =
+            {{"a", 1}, {"b", 2}, {"c", 3}, {"d", 4}, {"e", 5}};
+    EXPECT_EQ(test.range_count("b", "d", 0, 3), 2);
+    EXPECT_EQ(test.inverse().range_count(0, 3, "b", "d"), 2);
+    test.inverse().erase(2);
+    test.inverse().emplace(7, "bb");
+    EXPECT_EQ(test.range_count("b", "d", 0, 10), 3);
+    std::set<std::string> found;
+    test.inverse().range_query(3, 10, "a", "z", [&found](int, const std::string &s) { found.emplace(s); });
+    EXPECT_EQ(found, (std::set<std::string>{"bb", "c", "d", "e"}));
+    EXPECT_EQ(test.lower_bound("bb")->second, 7);
+}
+
+TEST(RangeIndexedMap, copy_and_clear) {
+    using namespace bimap;
+    bidirectional_map<int, int, range_indexed_map> test = {{1, 10}, {2, 20}, {3, 30}};
+    EXPECT_EQ(test.range_count(0, 5, 0, 100), 3);
+    auto copy = test;
+    test.clear();
+    EXPECT_EQ(test.range_count(0, 5, 0, 100), 0);
+    EXPECT_EQ(copy.range_count(2, 3, 0, 100), 2);
+    auto moved = std::move(copy);
+    moved.erase(2);
+    EXPECT_EQ(moved.range_count(0, 5, 0, 100), 2);
+}
+
+struct ThrowingLess {
+    static inline bool fail = false;
+
+    bool operator()(int lhs, int rhs) const {
+        if (fail) {
+            throw std::runtime_error("comparison failed");
+        }
+
+        return lhs < rhs;
+    }
+};
+
+TEST(RangeIndexedMap, erase_does_not_rebuild) {
+    using namespace bimap;
+    range_indexed_map<int, int, std::less<>, ThrowingLess> test;
+    for (int i = 0; i < 100; ++i) {
+        test.emplace(i, -i);
+    }
+
+    EXPECT_EQ(test.range_count(0, 99, -99, 0), 100);
+    test.emplace(100, -100);
+    // erasing most of the indexed elements does not compare anything
+    ThrowingLess::fail = true;
+    for (int i = 0; i < 90; ++i) {
+        EXPECT_NO_THROW(test.erase(i));
+    }
+
+    EXPECT_NO_THROW(test.erase(100));
+    ThrowingLess::fail = false;
+    EXPECT_EQ(test.size(), 10);
+    EXPECT_EQ(test.range_count(0, 200, -200, 0), 10);
+    EXPECT_EQ(test.range_count(95, 200, -200, -97), 3);
+    for (int i = 90; i < 100; ++i) {
+        test.erase(i);
+    }
+
+    EXPECT_EQ(test.range_count(0, 200, -200, 0), 0);
+}
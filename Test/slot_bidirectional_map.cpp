@@ -0,0 +1,169 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <random>
+#include <type_traits>
+
+#include "slot_bidirectional_map.hpp"
+#include "TestUtil.hpp"
+
+TEST(SlotBidirectionalMap, handles) {
+    using namespace bimap;
+    slot_bidirectional_map<std::string, int> map;
+    auto [a, insertedA] = map.emplace("a", 1);
+    auto [b, insertedB] = map.emplace("b", 2);
+    EXPECT_TRUE(insertedA && insertedB);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(map.emplace("a", 3), std::make_pair(a, false));
+    EXPECT_EQ(map.emplace("c", 2), std::make_pair(b, false));
+    EXPECT_EQ(map.find("b"), b);
+    EXPECT_EQ(map.inverse().find(1), a);
+    EXPECT_EQ(map.get(a).first, "a");
+    EXPECT_EQ(map.get(b).second, 2);
+    EXPECT_EQ(map.at("a"), 1);
+    EXPECT_EQ(map.inverse().at(2), "b");
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_FALSE(map.contains(a));
+    EXPECT_FALSE(map.contains("a"));
+    EXPECT_THROW(map.get(a), std::out_of_range);
+    EXPECT_THROW(map.at("a"), std::out_of_range);
+    auto [c, insertedC] = map.emplace("c", 1);
+    EXPECT_TRUE(insertedC);
+    EXPECT_EQ(c.index(), a.index());
+    EXPECT_NE(c, a);
+    EXPECT_FALSE(map.contains(a));
+    EXPECT_EQ(map.get(c).first, "c");
+    EXPECT_EQ(map.inverse().erase(2), 1);
+    EXPECT_EQ(map.size(), 1);
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        EXPECT_EQ(it.get_handle(), c);
+        EXPECT_EQ(it->first, "c");
+    }
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(c));
+    EXPECT_FALSE(map.contains(slot_handle()));
+    EXPECT_EQ(slot_handle::from_value(c.value()), c);
+}
+
+TEST(SlotBidirectionalMap, generation_exhaustion) {
+    using namespace bimap;
+    slot_bidirectional_map<int, int> map;
+    std::vector<slot_handle> handles;
+    for (std::uint32_t i = 0; i <= slot_handle::MaxGeneration; ++i) {
+        handles.emplace_back(map.emplace(i, i).first);
+        EXPECT_EQ(handles.back().index(), 0);
+        map.erase(handles.back());
+    }
+
+    // slot 0 is retired
+    auto h = map.emplace(-1, -1).first;
+    EXPECT_EQ(h.index(), 1);
+    for (auto old : handles) {
+        EXPECT_FALSE(map.contains(old));
+    }
+
+    map.clear();
+    EXPECT_EQ(map.emplace(1, 1).first.index(), 1);
+    map.reset();
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.contains(1));
+    // retired slots are recycled, old handles alias again
+    auto recycled = map.emplace(2, 2).first;
+    EXPECT_EQ(recycled, handles.front());
+    EXPECT_EQ(map.get(recycled).first, 2);
+    EXPECT_EQ(map.find(2), recycled);
+    EXPECT_EQ(map.inverse().find(2), recycled);
+}
+
+TEST(SlotBidirectionalMap, erase_from_copy) {
+    using namespace bimap;
+    slot_bidirectional_map<int, int> map;
+    std::vector<slot_handle> handles;
+    for (int i = 0; i < 100; ++i) {
+        handles.emplace_back(map.emplace(i, -i).first);
+    }
+
+    auto copy = map;
+    slot_bidirectional_map<int, int> assigned;
+    assigned = map;
+    for (auto h : handles) {
+        EXPECT_TRUE(copy.erase(h));
+        EXPECT_TRUE(assigned.erase(h));
+    }
+
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(assigned.empty());
+    EXPECT_EQ(map.size(), 100);
+    EXPECT_EQ(map.get(handles[42]).second, -42);
+    // all slots are reused after erasing from the copy
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_LT(copy.emplace(i, i).first.index(), 100);
+    }
+}
+
+TEST(SlotBidirectionalMap, random_operations) {
+    using namespace bimap;
+    slot_bidirectional_map<int, int> map;
+    std::unordered_map<int, slot_handle> reference;
+    std::mt19937 gen(8);
+    std::uniform_int_distribution<int> dist(0, 2000);
+    for (int i = 0; i < 50000; ++i) {
+        const auto key = dist(gen);
+        switch (gen() % 3) {
+            case 0: {
+                auto [h, inserted] = map.emplace(key, -key);
+                EXPECT_EQ(inserted, reference.emplace(key, h).second);
+                break;
+            }
+            case 1:
+                if (auto it = reference.find(key); it != reference.end()) {
+                    EXPECT_TRUE(map.erase(it->second));
+                    reference.erase(it);
+                } else {
+                    EXPECT_EQ(map.erase(key), 0);
+                }
+                break;
+            default:
+                EXPECT_EQ(map.inverse().erase(-key), reference.erase(key));
+        }
+    }
+
+    EXPECT_EQ(map.size(), reference.size());
+    for (auto [key, h] : reference) {
+        EXPECT_EQ(map.find(key), h);
+        EXPECT_EQ(map.inverse().find(-key), h);
+        EXPECT_EQ(map.get(h).second, -key);
+    }
+
+    std::size_t count = 0;
+    for (auto [key, value] : map) {
+        EXPECT_EQ(value, -key);
+        ++count;
+    }
+
+    EXPECT_EQ(count, reference.size());
+}
+
+TEST(SlotBidirectionalMap, const_inverse) {
+    using namespace bimap;
+    using Map = slot_bidirectional_map<int, int>;
+    Map map;
+    auto h = map.emplace(1, 2).first;
+    const auto &constMap = map;
+    auto view = constMap.inverse();
+    static_assert(std::is_same_v<decltype(view), Map::const_inverse_view>);
+    static_assert(std::is_same_v<decltype(view.inverse()), const Map &>);
+    static_assert(!can_erase<Map::const_inverse_view>::value);
+    static_assert(can_erase<Map::inverse_view>::value);
+    EXPECT_EQ(view.at(2), 1);
+    Map::const_inverse_view converted = map.inverse();
+    EXPECT_EQ(converted.find(2), h);
+    EXPECT_EQ(&converted.inverse(), &map);
+}
@@ -0,0 +1,246 @@
+//
+// Created by tim on 17.10.26.
+//
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <stdexcept>
+#include <type_traits>
+
+#include "static_bidirectional_map.hpp"
+#include "TestUtil.hpp"
+
+TEST(StaticBidirectionalMap, try_emplace) {
+    using namespace bimap;
+    static_bidirectional_map<int, std::string, 3> test;
+    EXPECT_TRUE(test.empty());
+    EXPECT_EQ(test.capacity(), 3);
+    EXPECT_TRUE(test.try_emplace(1, "a").second);
+    EXPECT_TRUE(test.try_emplace(2, "b").second);
+    auto [it, inserted] = test.try_emplace(1, "c");
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(it->second, "a");
+    EXPECT_FALSE(test.try_emplace(3, "b").second);
+    EXPECT_TRUE(test.try_emplace(3, "c").second);
+    EXPECT_TRUE(test.full());
+    auto res = test.try_emplace(4, "d");
+    EXPECT_FALSE(res.second);
+    EXPECT_EQ(res.first, test.end());
+    EXPECT_EQ(test.at(2), "b");
+    EXPECT_EQ(test.inverse().at("c"), 3);
+    EXPECT_EQ(test.inverse().find("a")->second, 1);
+    EXPECT_FALSE(test.contains(4));
+    EXPECT_THROW(test.at(4), std::out_of_range);
+    EXPECT_THROW(test.inverse().at("d"), std::out_of_range);
+    EXPECT_EQ(test.inverse().erase("a"), 1);
+    EXPECT_EQ(test.erase(1), 0);
+    EXPECT_TRUE(test.try_emplace(4, "d").second);
+    EXPECT_EQ(std::distance(test.begin(), test.end()), 3);
+    const auto copy = test;
+    test.clear();
+    EXPECT_TRUE(test.empty());
+    EXPECT_EQ(copy.size(), 3);
+    EXPECT_EQ(copy.inverse().at("d"), 4);
+    for (auto [key, value] : copy) {
+        EXPECT_EQ(copy.inverse().at(value), key);
+    }
+}
+
+TEST(StaticBidirectionalMap, const_inverse) {
+    using namespace bimap;
+    using Map = static_bidirectional_map<int, int, 4>;
+    Map map;
+    map.try_emplace(1, 2);
+    const auto &constMap = map;
+    auto view = constMap.inverse();
+    static_assert(std::is_same_v<decltype(view), Map::const_inverse_view>);
+    static_assert(std::is_same_v<decltype(view.inverse()), const Map &>);
+    static_assert(!can_erase<Map::const_inverse_view>::value);
+    static_assert(can_erase<Map::inverse_view>::value);
+    // the shared view keeps the exception specification of the map
+    static_assert(noexcept(view.find(2)) && noexcept(map.inverse().erase(2)));
+    EXPECT_EQ(view.at(2), 1);
+    Map::const_inverse_view converted = map.inverse();
+    EXPECT_EQ(converted.find(2)->second, 1);
+    EXPECT_EQ(&converted.inverse(), &map);
+}
+
+TEST(StaticBidirectionalMap, random_operations) {
+    using namespace bimap;
+    static_bidirectional_map<unsigned, unsigned, 200> test;
+    std::unordered_map<unsigned, unsigned> reference;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<unsigned> dist(0, 300);
+    for (int i = 0; i < 20000; ++i) {
+        const auto key = dist(gen);
+        if (gen() % 2 == 0) {
+            const auto inserted = test.try_emplace(key, key * 7).second;
+            EXPECT_EQ(inserted, reference.size() < 200 && reference.emplace(key, key * 7).second);
+        } else {
+            EXPECT_EQ(test.erase(key), reference.erase(key));
+        }
+    }
+
+    EXPECT_EQ(test.size(), reference.size());
+    for (auto [key, value] : reference) {
+        EXPECT_EQ(test.at(key), value);
+        EXPECT_EQ(test.inverse().at(value), key);
+    }
+
+    for (auto [value, key] : test.inverse()) {
+        EXPECT_EQ(reference.at(key), value);
+    }
+}
+
+struct CopyCounted {
+    static inline int alive = 0;
+    static inline int copiesUntilThrow = -1;
+    int value;
+
+    CopyCounted(int value) noexcept: value(value) {
+        ++alive;
+    }
+
+    CopyCounted(const CopyCounted &other) : value(other.value) {
+        if (copiesUntilThrow >= 0 && copiesUntilThrow-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+
+        ++alive;
+    }
+
+    CopyCounted(CopyCounted &&other) noexcept: value(other.value) {
+        ++alive;
+    }
+
+    CopyCounted &operator=(const CopyCounted &) = default;
+    CopyCounted &operator=(CopyCounted &&) noexcept = default;
+
+    ~CopyCounted() {
+        --alive;
+    }
+
+    bool operator==(const CopyCounted &other) const noexcept {
+        return value == other.value;
+    }
+};
+
+struct CopyCountedHash {
+    std::size_t operator()(const CopyCounted &item) const noexcept {
+        return std::hash<int>{}(item.value);
+    }
+};
+
+TEST(StaticBidirectionalMap, throwing_copy) {
+    using namespace bimap;
+    using Map = static_bidirectional_map<CopyCounted, int, 8, CopyCountedHash>;
+    {
+        Map source;
+        Map target;
+        for (int i = 0; i < 5; ++i) {
+            source.try_emplace(i, i);
+        }
+
+        target.try_emplace(10, 10);
+        target.try_emplace(11, 11);
+        EXPECT_EQ(CopyCounted::alive, 7);
+        CopyCounted::copiesUntilThrow = 3;
+        EXPECT_THROW(Map copy(source), std::runtime_error);
+        EXPECT_EQ(CopyCounted::alive, 7);
+        CopyCounted::copiesUntilThrow = 3;
+        EXPECT_THROW(target = source, std::runtime_error);
+        EXPECT_EQ(CopyCounted::alive, 7);
+        // target is unchanged
+        EXPECT_EQ(target.size(), 2);
+        EXPECT_EQ(target.at(10), 10);
+        EXPECT_EQ(target.inverse().at(11).value, 11);
+        CopyCounted::copiesUntilThrow = -1;
+        target = source;
+        EXPECT_EQ(target.size(), 5);
+        EXPECT_EQ(target.inverse().at(4).value, 4);
+        Map other;
+        other.try_emplace(20, 20);
+        swap(other, target);
+        EXPECT_EQ(other.size(), 5);
+        EXPECT_EQ(target.size(), 1);
+        EXPECT_EQ(other.at(3), 3);
+        EXPECT_EQ(target.inverse().at(20).value, 20);
+        EXPECT_FALSE(target.contains(3));
+        EXPECT_EQ(CopyCounted::alive, 11);
+    }
+
+    EXPECT_EQ(CopyCounted::alive, 0);
+}
+
+struct AssignCounted {
+    static inline int alive = 0;
+    static inline int copiesUntilThrow = -1;
+    int value;
+
+    AssignCounted(int value) noexcept: value(value) {
+        ++alive;
+    }
+
+    AssignCounted(const AssignCounted &other) : value(other.value) {
+        countCopy();
+        ++alive;
+    }
+
+    AssignCounted &operator=(const AssignCounted &other) {
+        countCopy();
+        value = other.value;
+        return *this;
+    }
+
+    ~AssignCounted() {
+        --alive;
+    }
+
+    bool operator==(const AssignCounted &other) const noexcept {
+        return value == other.value;
+    }
+
+private:
+    static void countCopy() {
+        if (copiesUntilThrow >= 0 && copiesUntilThrow-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+};
+
+struct AssignCountedHash {
+    std::size_t operator()(const AssignCounted &item) const noexcept {
+        return std::hash<int>{}(item.value);
+    }
+};
+
+TEST(StaticBidirectionalMap, throwing_erase) {
+    using namespace bimap;
+    using Map = static_bidirectional_map<AssignCounted, int, 8, AssignCountedHash>;
+    static_assert(!noexcept(std::declval<Map &>().erase(AssignCounted(0))));
+    {
+        Map map;
+        for (int i = 0; i < 5; ++i) {
+            map.try_emplace(i, i);
+        }
+
+        // erasing the last pair does not move anything
+        EXPECT_EQ(map.erase(4), 1);
+        EXPECT_EQ(AssignCounted::alive, 4);
+        EXPECT_EQ(map.erase(1), 1);
+        EXPECT_EQ(AssignCounted::alive, 3);
+        EXPECT_EQ(map.at(3), 3);
+        EXPECT_EQ(map.inverse().at(3).value, 3);
+        AssignCounted::copiesUntilThrow = 0;
+        EXPECT_THROW(map.inverse().erase(0), std::runtime_error);
+        AssignCounted::copiesUntilThrow = -1;
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(AssignCounted::alive, 0);
+        map.try_emplace(7, 7);
+        EXPECT_EQ(map.inverse().at(7).value, 7);
+        EXPECT_EQ(AssignCounted::alive, 1);
+    }
+
+    EXPECT_EQ(AssignCounted::alive, 0);
+}
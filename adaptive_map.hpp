@@ -0,0 +1,716 @@
+/**
+ * @file adaptive_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains an associative container that adapts its lookup structure to its size and access
+ * pattern. It can be used as base container for bimap::bidirectional_map.
+ */
+
+#ifndef BIDIRECTIONALMAP_ADAPTIVE_MAP_HPP
+#define BIDIRECTIONALMAP_ADAPTIVE_MAP_HPP
+
+#include <deque>
+#include <vector>
+#include <array>
+#include <optional>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+#include <new>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Associative container with unique keys that switches its lookup structure depending on size and access
+     * pattern.
+     * @details Elements are stored in a pool of slots and never move, references therefore stay valid until the
+     * element is erased. Only the index over the slots changes representation:
+     * - up to small_size elements, lookup is a linear scan over an inline array of slot indices
+     * - above that, lookup uses a flat open addressing table of slot indices. The table is rebuilt at half its size
+     *   when it is less than 1/8 full and migrates back to the inline array once fewer than small_size / 2 elements
+     *   remain. Live slots are linked in insertion order, so migrations are linear in the number of elements, not
+     *   in the peak number of slots
+     * - the first call to lower_bound or upper_bound builds an ordered index (a sorted array of slot indices). New
+     *   elements are appended to an unsorted tail and erased elements leave tombstones, both are merged by the next
+     *   ordered query. If the tail grows larger than the sorted array without any ordered query, the ordered index
+     *   is dropped again
+     *
+     * begin() iterates in insertion order, iterators returned by lower_bound and upper_bound iterate in key order and see
+     * elements inserted after their creation, like iterators of std::map. All migrations only touch the index, so
+     * iterators stay valid across them: emplace does not invalidate iterators and erase only invalidates iterators to
+     * the erased element. The ordered index is a cache maintained by const member
+     * functions, concurrent calls to lower_bound or upper_bound therefore require synchronization.
+     * ```
+     * bimap::bidirectional_map<int, std::string, bimap::adaptive_map, bimap::adaptive_map> map;
+     * map.emplace(1, "a");
+     * for (auto it = map.lower_bound(0); it != map.end(); ++it) {...} // in key order
+     * ```
+     * @tparam Key key type
+     * @tparam T mapped type
+     * @tparam Hash hash function
+     * @tparam Compare comparator used by the ordered index
+     * @tparam KeyEqual key equality comparator
+     */
+    template<typename Key, typename T, typename Hash = std::hash<Key>, typename Compare = std::less<Key>,
+             typename KeyEqual = std::equal_to<Key>>
+    class adaptive_map {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const Key, T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        /**
+         * Maximum number of elements indexed by the inline array
+         */
+        static constexpr std::size_t small_size = 8;
+
+    private:
+        static constexpr std::size_t Empty = std::numeric_limits<std::size_t>::max();
+        static constexpr std::size_t MinTail = 16;
+
+        struct Slot {
+            std::optional<value_type> item;
+            // position in the sorted index or in the tail
+            mutable std::size_t orderPos = Empty;
+            mutable bool inTail = false;
+            // neighbours in the list of live slots
+            std::size_t prevLive = Empty;
+            std::size_t nextLive = Empty;
+        };
+
+        template<bool Const>
+        class Iterator {
+            friend class adaptive_map;
+            using Owner = std::conditional_t<Const, const adaptive_map, adaptive_map>;
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = typename adaptive_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const value_type &, value_type &>;
+            using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+
+            Iterator() noexcept = default;
+
+            /**
+             * Conversion from mutable to const iterator
+             * @param other source
+             */
+            template<bool C = Const, typename = std::enable_if_t<C>>
+            Iterator(const Iterator<false> &other) noexcept: owner(other.owner), index(other.index),
+                                                             ordered(other.ordered) {}
+
+            reference operator*() const noexcept {
+                return *owner->slots[index].item;
+            }
+
+            pointer operator->() const noexcept {
+                return &**this;
+            }
+
+            Iterator &operator++() {
+                if (ordered) {
+                    owner->updateOrderedIndex();
+                    const auto next = owner->slots[index].orderPos + 1;
+                    index = next < owner->sorted.size() ? owner->sorted[next] : Empty;
+                } else {
+                    index = owner->slots[index].nextLive;
+                }
+
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            Iterator &operator--() {
+                if (ordered) {
+                    owner->updateOrderedIndex();
+                    index = owner->sorted[index == Empty ? owner->sorted.size() - 1
+                                                         : owner->slots[index].orderPos - 1];
+                } else {
+                    index = index == Empty ? owner->lastLive : owner->slots[index].prevLive;
+                }
+
+                return *this;
+            }
+
+            Iterator operator--(int) {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            bool operator==(const Iterator &other) const noexcept {
+                return index == other.index;
+            }
+
+            bool operator!=(const Iterator &other) const noexcept {
+                return index != other.index;
+            }
+
+        private:
+            Iterator(Owner *owner, std::size_t index, bool ordered) noexcept: owner(owner), index(index),
+                                                                              ordered(ordered) {}
+
+            Owner *owner = nullptr;
+            // slot of the element or Empty for end iterators
+            std::size_t index = Empty;
+            bool ordered = false;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        adaptive_map() = default;
+
+        /**
+         * Copy constructor
+         * @param other source
+         */
+        adaptive_map(const adaptive_map &other)
+                : slots(other.slots), freeSlots(other.freeSlots), small(other.small), numSmall(other.numSmall),
+                  table(other.table), sorted(other.sorted), tail(other.tail), numTombstones(other.numTombstones),
+                  hasOrderedIndex(other.hasOrderedIndex), firstLive(other.firstLive), lastLive(other.lastLive),
+                  numElements(other.numElements) {
+            // copying a vector does not copy its capacity
+            freeSlots.reserve(slots.size());
+        }
+
+        adaptive_map(adaptive_map &&) = default;
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to *this
+         */
+        adaptive_map &operator=(const adaptive_map &other) {
+            if (this != &other) {
+                *this = adaptive_map(other);
+            }
+
+            return *this;
+        }
+
+        adaptive_map &operator=(adaptive_map &&) = default;
+
+        iterator begin() noexcept {
+            return iterator(this, firstLive, false);
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(this, firstLive, false);
+        }
+
+        iterator end() noexcept {
+            return iterator(this, Empty, false);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(this, Empty, false);
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return numElements;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return numElements == 0;
+        }
+
+        /**
+         * Whether lookup currently uses the inline array
+         */
+        [[nodiscard]] bool is_small() const noexcept {
+            return table.empty();
+        }
+
+        /**
+         * Number of positions in the current lookup index: small_size for the inline array, otherwise the size of
+         * the table
+         */
+        [[nodiscard]] size_type index_capacity() const noexcept {
+            return is_small() ? small_size : table.size();
+        }
+
+        /**
+         * Whether the ordered index currently exists
+         */
+        [[nodiscard]] bool has_ordered_index() const noexcept {
+            return hasOrderedIndex;
+        }
+
+        /**
+         * Erases all elements from the container
+         */
+        void clear() noexcept {
+            slots.clear();
+            freeSlots.clear();
+            numSmall = 0;
+            table.clear();
+            dropOrderedIndex();
+            firstLive = lastLive = Empty;
+            numElements = 0;
+        }
+
+        /**
+         * Reserves space in the lookup table for the given number of elements
+         * @param count number of elements
+         */
+        void reserve(size_type count) {
+            if (count > small_size && 2 * count > table.size()) {
+                rehash(count);
+            }
+        }
+
+        /**
+         * Constructs an element in place if no element with equivalent key exists. Does not invalidate iterators
+         * @tparam ARGS argument types
+         * @param args arguments forwarded to the constructor of value_type
+         * @return std::pair(iterator to inserted or already existing element, bool whether insertion happened)
+         */
+        template<typename ...ARGS>
+        auto emplace(ARGS &&...args) -> std::pair<iterator, bool> {
+            // construct the element in a free slot first to avoid copying or moving the key
+            std::size_t index;
+            if (freeSlots.empty()) {
+                index = slots.size();
+                if (freeSlots.capacity() <= index) {
+                    // erase pushes to freeSlots and must not allocate
+                    freeSlots.reserve(std::max(2 * freeSlots.capacity(), index + 1));
+                }
+
+                slots.emplace_back();
+            } else {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            auto &slot = slots[index];
+            try {
+                slot.item.emplace(std::forward<ARGS>(args)...);
+            } catch (...) {
+                releaseSlot(index);
+                throw;
+            }
+
+            if (auto existing = lookup(slot.item->first); existing != Empty) {
+                slot.item.reset();
+                releaseSlot(index);
+                return {iterator(this, existing, false), false};
+            }
+
+            try {
+                insertIndex(index);
+            } catch (...) {
+                slot.item.reset();
+                releaseSlot(index);
+                throw;
+            }
+
+            link(index);
+            ++numElements;
+            if (hasOrderedIndex) {
+                slot.inTail = true;
+                slot.orderPos = tail.size();
+                tail.emplace_back(index);
+                if (tail.size() > std::max(MinTail, sorted.size())) {
+                    // no ordered queries for a long time
+                    dropOrderedIndex();
+                }
+            }
+
+            return {iterator(this, index, false), true};
+        }
+
+        /**
+         * Erases the element at position pos. Only iterators to the erased element are invalidated
+         * @param pos valid dereferenceable iterator
+         * @return iterator following the removed element, in key order if pos was obtained from an ordered query
+         */
+        iterator erase(const_iterator pos) {
+            iterator next(this, pos.index, pos.ordered);
+            ++next;
+            const auto index = pos.index;
+            eraseIndex(index);
+            auto &slot = slots[index];
+            if (hasOrderedIndex) {
+                if (slot.inTail) {
+                    tail[slot.orderPos] = tail.back();
+                    slots[tail.back()].orderPos = slot.orderPos;
+                    tail.pop_back();
+                } else {
+                    sorted[slot.orderPos] = Empty;
+                    ++numTombstones;
+                }
+            }
+
+            unlink(index);
+            slot.item.reset();
+            slot.inTail = false;
+            slot.orderPos = Empty;
+            releaseSlot(index);
+            --numElements;
+            if (!is_small() && (8 * numElements < table.size() || numElements < small_size / 2)) {
+                try {
+                    shrinkIndex();
+                } catch (const std::bad_alloc &) {
+                    // the sparse table is still valid
+                }
+            }
+
+            return next;
+        }
+
+        /**
+         * Erases the element with key equivalent to key if it exists
+         * @param key key used for lookup
+         * @return number of erased elements
+         */
+        size_type erase(const Key &key) {
+            auto it = find(key);
+            if (it == end()) {
+                return 0;
+            }
+
+            erase(it);
+            return 1;
+        }
+
+        iterator find(const Key &key) {
+            auto index = lookup(key);
+            return index == Empty ? end() : iterator(this, index, false);
+        }
+
+        const_iterator find(const Key &key) const {
+            return const_cast<adaptive_map *>(this)->find(key);
+        }
+
+        size_type count(const Key &key) const {
+            return lookup(key) == Empty ? 0 : 1;
+        }
+
+        /**
+         * First element in key order whose key is not less than key. Builds or updates the ordered index
+         * @param key key used for lookup
+         * @return iterator that iterates in key order
+         */
+        iterator lower_bound(const Key &key) {
+            return iterator(this, lowerBoundSlot(key), true);
+        }
+
+        const_iterator lower_bound(const Key &key) const {
+            return const_iterator(this, lowerBoundSlot(key), true);
+        }
+
+        /**
+         * First element in key order whose key is greater than key. Builds or updates the ordered index
+         * @param key key used for lookup
+         * @return iterator that iterates in key order
+         */
+        iterator upper_bound(const Key &key) {
+            return iterator(this, upperBoundSlot(key), true);
+        }
+
+        const_iterator upper_bound(const Key &key) const {
+            return const_iterator(this, upperBoundSlot(key), true);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key) {
+            auto it = find(key);
+            return {it, it == end() ? it : std::next(it)};
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+            return const_cast<adaptive_map *>(this)->equal_range(key);
+        }
+
+        /**
+         * Swaps the contents of the containers
+         * @param other swap target
+         */
+        void swap(adaptive_map &other) noexcept {
+            using std::swap;
+            swap(slots, other.slots);
+            swap(freeSlots, other.freeSlots);
+            swap(small, other.small);
+            swap(numSmall, other.numSmall);
+            swap(table, other.table);
+            swap(sorted, other.sorted);
+            swap(tail, other.tail);
+            swap(numTombstones, other.numTombstones);
+            swap(hasOrderedIndex, other.hasOrderedIndex);
+            swap(firstLive, other.firstLive);
+            swap(lastLive, other.lastLive);
+            swap(numElements, other.numElements);
+        }
+
+        /**
+         * Element wise comparison independent of the order of elements
+         * @param other right hand side
+         * @return true if both containers contain equal elements
+         */
+        bool operator==(const adaptive_map &other) const {
+            if (size() != other.size()) {
+                return false;
+            }
+
+            return std::all_of(begin(), end(), [&other](const value_type &item) {
+                auto it = other.find(item.first);
+                return it != other.end() && it->second == item.second;
+            });
+        }
+
+        bool operator!=(const adaptive_map &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        /**
+         * Returns a slot to the pool. Does not allocate since emplace reserves room for all slots in freeSlots
+         */
+        void releaseSlot(std::size_t index) noexcept {
+            if (index + 1 == slots.size()) {
+                slots.pop_back();
+            } else {
+                freeSlots.emplace_back(index);
+            }
+        }
+
+        /**
+         * Appends a slot to the list of live slots
+         */
+        void link(std::size_t index) noexcept {
+            slots[index].prevLive = lastLive;
+            slots[index].nextLive = Empty;
+            (lastLive == Empty ? firstLive : slots[lastLive].nextLive) = index;
+            lastLive = index;
+        }
+
+        /**
+         * Removes a slot from the list of live slots
+         */
+        void unlink(std::size_t index) noexcept {
+            auto &slot = slots[index];
+            (slot.prevLive == Empty ? firstLive : slots[slot.prevLive].nextLive) = slot.nextLive;
+            (slot.nextLive == Empty ? lastLive : slots[slot.nextLive].prevLive) = slot.prevLive;
+            slot.prevLive = slot.nextLive = Empty;
+        }
+
+        std::size_t home(const Key &key) const {
+            return static_cast<std::size_t>(impl::mix_bits(static_cast<std::uint64_t>(Hash{}(key)))) &
+                   (table.size() - 1);
+        }
+
+        /**
+         * Slot index of key or Empty
+         */
+        std::size_t lookup(const Key &key) const {
+            if (is_small()) {
+                for (std::size_t i = 0; i < numSmall; ++i) {
+                    if (KeyEqual{}(slots[small[i]].item->first, key)) {
+                        return small[i];
+                    }
+                }
+
+                return Empty;
+            }
+
+            return table[findTablePos(key)];
+        }
+
+        /**
+         * Position of key in the table or the empty position where it would be inserted
+         */
+        std::size_t findTablePos(const Key &key) const {
+            const auto mask = table.size() - 1;
+            auto pos = home(key);
+            while (table[pos] != Empty && !KeyEqual{}(slots[table[pos]].item->first, key)) {
+                pos = (pos + 1) & mask;
+            }
+
+            return pos;
+        }
+
+        void insertIndex(std::size_t index) {
+            if (is_small() && numSmall < small_size) {
+                small[numSmall++] = index;
+                return;
+            }
+
+            if (is_small() || 2 * (numElements + 1) > table.size()) {
+                rehash(numElements + 1);
+            }
+
+            table[findTablePos(slots[index].item->first)] = index;
+        }
+
+        void eraseIndex(std::size_t index) {
+            if (is_small()) {
+                auto pos = std::find(small.begin(), small.begin() + static_cast<std::ptrdiff_t>(numSmall), index);
+                *pos = small[--numSmall];
+                return;
+            }
+
+            // backward shift deletion for linear probing
+            const auto mask = table.size() - 1;
+            auto hole = findTablePos(slots[index].item->first);
+            for (auto curr = (hole + 1) & mask; table[curr] != Empty; curr = (curr + 1) & mask) {
+                const auto desired = home(slots[table[curr]].item->first);
+                const bool movable = hole <= curr ? (desired <= hole || desired > curr)
+                                                  : (desired <= hole && desired > curr);
+                if (movable) {
+                    table[hole] = table[curr];
+                    hole = curr;
+                }
+            }
+
+            table[hole] = Empty;
+        }
+
+        /**
+         * Migrates to a table with room for at least count elements
+         */
+        void rehash(std::size_t count) {
+            std::size_t capacity = 2 * small_size;
+            while (capacity < 2 * count) {
+                capacity *= 2;
+            }
+
+            std::vector<std::size_t>(capacity, Empty).swap(table);
+            numSmall = 0;
+            for (auto i = firstLive; i != Empty; i = slots[i].nextLive) {
+                table[findTablePos(slots[i].item->first)] = i;
+            }
+        }
+
+        /**
+         * Rebuilds a sparse table at half load or migrates back to the inline array. Only called when the table is
+         * less than 1/8 full or nearly empty, so the cost is amortized over the erasures since the last migration
+         */
+        void shrinkIndex() {
+            if (numElements >= small_size / 2) {
+                rehash(numElements);
+                return;
+            }
+
+            table.clear();
+            table.shrink_to_fit();
+            numSmall = 0;
+            for (auto i = firstLive; i != Empty; i = slots[i].nextLive) {
+                small[numSmall++] = i;
+            }
+        }
+
+        void dropOrderedIndex() const noexcept {
+            for (auto index : tail) {
+                slots[index].inTail = false;
+                slots[index].orderPos = Empty;
+            }
+
+            for (auto index : sorted) {
+                if (index != Empty) {
+                    slots[index].orderPos = Empty;
+                }
+            }
+
+            sorted.clear();
+            sorted.shrink_to_fit();
+            tail.clear();
+            tail.shrink_to_fit();
+            numTombstones = 0;
+            hasOrderedIndex = false;
+        }
+
+        /**
+         * Builds the ordered index or merges the tail and removes tombstones
+         */
+        void updateOrderedIndex() const {
+            auto less = [this](std::size_t lhs, std::size_t rhs) {
+                return Compare{}(slots[lhs].item->first, slots[rhs].item->first);
+            };
+
+            if (!hasOrderedIndex) {
+                sorted.reserve(numElements);
+                for (auto i = firstLive; i != Empty; i = slots[i].nextLive) {
+                    sorted.emplace_back(i);
+                }
+
+                std::sort(sorted.begin(), sorted.end(), less);
+                hasOrderedIndex = true;
+            } else if (!tail.empty() || numTombstones > 0) {
+                sorted.erase(std::remove(sorted.begin(), sorted.end(), Empty), sorted.end());
+                std::sort(tail.begin(), tail.end(), less);
+                const auto oldSize = static_cast<std::ptrdiff_t>(sorted.size());
+                sorted.insert(sorted.end(), tail.begin(), tail.end());
+                std::inplace_merge(sorted.begin(), sorted.begin() + oldSize, sorted.end(), less);
+                for (auto index : tail) {
+                    slots[index].inTail = false;
+                }
+
+                tail.clear();
+                numTombstones = 0;
+            } else {
+                return;
+            }
+
+            for (std::size_t i = 0; i < sorted.size(); ++i) {
+                slots[sorted[i]].orderPos = i;
+            }
+        }
+
+        std::size_t lowerBoundSlot(const Key &key) const {
+            updateOrderedIndex();
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), key, [this](std::size_t i, const Key &k) {
+                return Compare{}(slots[i].item->first, k);
+            });
+            return it == sorted.end() ? Empty : *it;
+        }
+
+        std::size_t upperBoundSlot(const Key &key) const {
+            updateOrderedIndex();
+            auto it = std::upper_bound(sorted.begin(), sorted.end(), key, [this](const Key &k, std::size_t i) {
+                return Compare{}(k, slots[i].item->first);
+            });
+            return it == sorted.end() ? Empty : *it;
+        }
+
+        std::deque<Slot> slots;
+        std::vector<std::size_t> freeSlots;
+        std::array<std::size_t, small_size> small{};
+        std::size_t numSmall = 0;
+        std::vector<std::size_t> table;
+        // the ordered index is a cache maintained by const ordered queries
+        mutable std::vector<std::size_t> sorted;
+        mutable std::vector<std::size_t> tail;
+        mutable std::size_t numTombstones = 0;
+        mutable bool hasOrderedIndex = false;
+        // list of live slots in insertion order
+        std::size_t firstLive = Empty;
+        std::size_t lastLive = Empty;
+        std::size_t numElements = 0;
+    };
+
+    /**
+     * See member function adaptive_map::swap
+     * @param lhs left hand side
+     * @param rhs right hand side
+     */
+    template<typename Key, typename T, typename Hash, typename Compare, typename KeyEqual>
+    void swap(adaptive_map<Key, T, Hash, Compare, KeyEqual> &lhs,
+              adaptive_map<Key, T, Hash, Compare, KeyEqual> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_ADAPTIVE_MAP_HPP
@@ -0,0 +1,910 @@
+/**
+ * @file algorithms.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains free algorithms operating on whole bidirectional_maps. Algorithms taking an execution
+ * policy distribute the work over multiple threads when given std::execution::par or std::execution::par_unseq.
+ */
+
+#ifndef BIDIRECTIONALMAP_ALGORITHMS_HPP
+#define BIDIRECTIONALMAP_ALGORITHMS_HPP
+
+#include <execution>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <iterator>
+
+#include "bidirectional_map.hpp"
+#include "parallel.hpp"
+
+namespace bimap::impl {
+    namespace traits {
+        template<typename T, typename = std::void_t<>>
+        struct has_bucket_interface : std::false_type {};
+
+        template<typename T>
+        struct has_bucket_interface<T, std::void_t<decltype(std::declval<const T &>().bucket_count()),
+                decltype(std::declval<const T &>().begin(std::size_t{})),
+                decltype(std::declval<const T &>().end(std::size_t{}))>> : std::true_type {};
+
+        template<typename T, typename = std::void_t<>>
+        struct is_ordered : std::false_type {};
+
+        template<typename T>
+        struct is_ordered<T, std::void_t<decltype(std::declval<const T &>().key_comp())>> : std::true_type {};
+
+        template<typename BiMap>
+        constexpr bool has_unique_keys =
+                !is_multimap_v<std::decay_t<decltype(BaseAccess::forward(std::declval<const BiMap &>()))>> &&
+                !is_multimap_v<std::decay_t<decltype(BaseAccess::forward(std::declval<const BiMap &>().inverse()))>>;
+
+        template<typename Policy>
+        constexpr bool is_execution_policy = std::is_execution_policy_v<std::decay_t<Policy>>;
+
+        template<typename Policy>
+        constexpr bool is_parallel_policy = is_execution_policy<Policy> &&
+                !std::is_same_v<std::decay_t<Policy>, std::execution::sequenced_policy>;
+    }
+
+    /**
+     * Number of chunks handed out per thread. More chunks than threads allow threads that finish early to take over
+     * the remaining work
+     */
+    constexpr std::size_t ChunksPerThread = 8;
+
+    /**
+     * @brief Partition of a base container into disjoint chunks that can be processed concurrently
+     * @details Unordered containers are split along bucket boundaries. Other containers are split along iterator
+     * positions that are collected in one pass on construction. Chunks of such containers as well as a single chunk
+     * covering the whole container preserve the iteration order of the container
+     * @tparam Map base container type
+     */
+    template<typename Map>
+    class Chunks {
+        using Iterator = decltype(std::declval<const Map &>().begin());
+    public:
+        /**
+         * CTor
+         * @param map base container
+         * @param numThreads number of threads that will process the chunks. The whole container is one chunk if this
+         * is 1
+         */
+        Chunks(const Map &map, std::size_t numThreads) : map(&map) {
+            if (numThreads <= 1 || map.size() < 2) {
+                bounds = {map.begin(), map.end()};
+                return;
+            }
+
+            if constexpr (traits::has_bucket_interface<Map>::value) {
+                numBuckets = map.bucket_count();
+                numChunks = std::min(numBuckets, numThreads * ChunksPerThread);
+            } else {
+                const std::size_t chunkSize = std::max<std::size_t>(map.size() / (numThreads * ChunksPerThread), 1);
+                bounds.reserve(map.size() / chunkSize + 2);
+                std::size_t pos = 0;
+                for (auto it = map.begin(); it != map.end(); ++it, ++pos) {
+                    if (pos % chunkSize == 0) {
+                        bounds.emplace_back(it);
+                    }
+                }
+
+                bounds.emplace_back(map.end());
+            }
+        }
+
+        /**
+         * Number of chunks
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return bounds.empty() ? numChunks : bounds.size() - 1;
+        }
+
+        /**
+         * Calls rangeFn(first, last) for every iterator range in the given chunk
+         * @param chunk chunk index
+         * @param rangeFn function that is called with the iterator ranges of the chunk
+         */
+        template<typename RangeFn>
+        void for_each_range(std::size_t chunk, RangeFn &&rangeFn) const {
+            if (!bounds.empty()) {
+                rangeFn(bounds[chunk], bounds[chunk + 1]);
+                return;
+            }
+
+            if constexpr (traits::has_bucket_interface<Map>::value) {
+                const auto last = (chunk + 1) * numBuckets / numChunks;
+                for (auto bucket = chunk * numBuckets / numChunks; bucket < last; ++bucket) {
+                    rangeFn(map->begin(bucket), map->end(bucket));
+                }
+            }
+        }
+
+        /**
+         * Calls itemFn(it) for every iterator it in the given chunk
+         * @param chunk chunk index
+         * @param itemFn function that is called with an iterator to each element in the chunk
+         */
+        template<typename ItemFn>
+        void for_each_item(std::size_t chunk, ItemFn &&itemFn) const {
+            for_each_range(chunk, [&itemFn](auto first, auto last) {
+                for (; first != last; ++first) {
+                    itemFn(first);
+                }
+            });
+        }
+
+    private:
+        const Map *map;
+        std::vector<Iterator> bounds;
+        std::size_t numBuckets = 0;
+        std::size_t numChunks = 0;
+    };
+
+    /**
+     * Splits the base container into disjoint chunks (see Chunks) and calls chunkFn(visit) once per chunk, possibly
+     * concurrently. visit(itemFn) calls itemFn(it) for every iterator it in the chunk
+     * @tparam Map base container type
+     * @tparam ChunkFn chunk function type
+     * @param map base container
+     * @param numThreads maximum number of threads. The whole container is one chunk if this is 1
+     * @param chunkFn function that is called for every chunk
+     */
+    template<typename Map, typename ChunkFn>
+    void for_each_chunk(const Map &map, std::size_t numThreads, ChunkFn &&chunkFn) {
+        Chunks<Map> chunks(map, numThreads);
+        parallel_for(chunks.size(), [&chunks, &chunkFn](std::size_t chunk) {
+            chunkFn([&chunks, chunk](auto &&itemFn) {
+                chunks.for_each_item(chunk, itemFn);
+            });
+        }, numThreads);
+    }
+
+    /**
+     * Hint to the processor to load the cache line containing ptr
+     */
+    inline void prefetch(const void *ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(ptr);
+#else
+        static_cast<void>(ptr);
+#endif
+    }
+
+    /**
+     * Number of elements between the element currently being copied and the element whose inverse key is prefetched
+     */
+    constexpr std::size_t PrefetchDistance = 8;
+
+    /**
+     * Copies forward and inverse keys of the base container range [first, last) to the output columns. Inverse keys
+     * are prefetched ahead of time since they are located in the nodes of the inverse container
+     * @return number of copied elements
+     */
+    template<typename Iterator, typename ForwardOut, typename InverseOut>
+    std::size_t copy_columns(Iterator first, Iterator last, ForwardOut forwardOut, InverseOut inverseOut) {
+        auto ahead = first;
+        for (std::size_t i = 0; i < PrefetchDistance && ahead != last; ++i, ++ahead) {
+            prefetch(&*ahead->second);
+        }
+
+        std::size_t count = 0;
+        for (; first != last; ++first, ++count, ++forwardOut, ++inverseOut) {
+            if (ahead != last) {
+                prefetch(&*ahead->second);
+                ++ahead;
+            }
+
+            *forwardOut = first->first;
+            *inverseOut = *first->second;
+        }
+
+        return count;
+    }
+
+    /**
+     * Reserves space in the map if supported, otherwise does nothing
+     */
+    template<typename BiMap>
+    void try_reserve(BiMap &map, std::size_t count) {
+        if constexpr (traits::has_reserve<BiMap>::value) {
+            map.reserve(count);
+        }
+    }
+
+    /**
+     * Walks over the forward keys of two maps of the same type and calls
+     * - both(key, lhsValue, rhsValue) for keys contained in both maps
+     * - onlyLhs(key, lhsValue) for keys only contained in lhs (only if VisitOnlyLhs is set)
+     * - onlyRhs(key, rhsValue) for keys only contained in rhs (only if VisitOnlyRhs is set)
+     *
+     * Ordered base containers are merged in a single sorted pass. Otherwise, the keys of one map are looked up in the
+     * other one. If only keys contained in both maps are of interest, the smaller map is used for probing
+     * @tparam VisitOnlyLhs whether onlyLhs is called
+     * @tparam VisitOnlyRhs whether onlyRhs is called
+     */
+    template<bool VisitOnlyLhs, bool VisitOnlyRhs, typename BiMap, typename Both, typename OnlyLhs, typename OnlyRhs>
+    void merge_walk(const BiMap &lhs, const BiMap &rhs, Both &&both, OnlyLhs &&onlyLhs, OnlyRhs &&onlyRhs) {
+        using Base = std::decay_t<decltype(BaseAccess::forward(lhs))>;
+        if constexpr (traits::is_ordered<Base>::value) {
+            auto comp = BaseAccess::forward(lhs).key_comp();
+            auto l = lhs.begin();
+            auto r = rhs.begin();
+            while (l != lhs.end() && r != rhs.end()) {
+                if (comp(l->first, r->first)) {
+                    if constexpr (VisitOnlyLhs) {
+                        onlyLhs(l->first, l->second);
+                    }
+
+                    ++l;
+                } else if (comp(r->first, l->first)) {
+                    if constexpr (VisitOnlyRhs) {
+                        onlyRhs(r->first, r->second);
+                    }
+
+                    ++r;
+                } else {
+                    both(l->first, l->second, r->second);
+                    ++l;
+                    ++r;
+                }
+            }
+
+            if constexpr (VisitOnlyLhs) {
+                for (; l != lhs.end(); ++l) {
+                    onlyLhs(l->first, l->second);
+                }
+            }
+
+            if constexpr (VisitOnlyRhs) {
+                for (; r != rhs.end(); ++r) {
+                    onlyRhs(r->first, r->second);
+                }
+            }
+        } else if constexpr (!VisitOnlyLhs && !VisitOnlyRhs) {
+            if (rhs.size() < lhs.size()) {
+                for (const auto &[key, value] : rhs) {
+                    if (auto res = lhs.find(key); res != lhs.end()) {
+                        both(key, res->second, value);
+                    }
+                }
+            } else {
+                for (const auto &[key, value] : lhs) {
+                    if (auto res = rhs.find(key); res != rhs.end()) {
+                        both(key, value, res->second);
+                    }
+                }
+            }
+        } else {
+            for (const auto &[key, value] : lhs) {
+                if (auto res = rhs.find(key); res != rhs.end()) {
+                    both(key, value, res->second);
+                } else if constexpr (VisitOnlyLhs) {
+                    onlyLhs(key, value);
+                }
+            }
+
+            if constexpr (VisitOnlyRhs) {
+                for (const auto &[key, value] : rhs) {
+                    if (lhs.find(key) == lhs.end()) {
+                        onlyRhs(key, value);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Collects the items of source that are not contained in other, using multiple threads
+     * @return pointers to forward and inverse keys of the found items in source
+     */
+    template<typename BiMap, typename ForwardKey, typename InverseKey>
+    auto missing_items(const BiMap &source, const BiMap &other, std::size_t numThreads)
+    -> std::vector<std::pair<const ForwardKey *, const InverseKey *>> {
+        std::vector<std::pair<const ForwardKey *, const InverseKey *>> ret;
+        std::mutex mutex;
+        for_each_chunk(BaseAccess::forward(source), numThreads, [&other, &ret, &mutex](auto &&visit) {
+            std::vector<std::pair<const ForwardKey *, const InverseKey *>> local;
+            visit([&other, &local](const auto &it) {
+                auto res = other.find(it->first);
+                if (res == other.end() || !(res->second == *it->second)) {
+                    local.emplace_back(&it->first, &*it->second);
+                }
+            });
+
+            if (!local.empty()) {
+                std::lock_guard lock(mutex);
+                ret.insert(ret.end(), local.begin(), local.end());
+            }
+        });
+
+        return ret;
+    }
+
+    /**
+     * Number of threads to use for the given execution policy
+     */
+    template<typename ExecutionPolicy>
+    std::size_t concurrency_for(const ExecutionPolicy &) noexcept {
+        if constexpr (traits::is_parallel_policy<ExecutionPolicy>) {
+            return default_concurrency();
+        } else {
+            return 1;
+        }
+    }
+}
+
+namespace bimap {
+    /**
+     * Calls fn(forwardKey, inverseKey) for every item in the map. With a parallel execution policy fn is called
+     * concurrently from multiple threads in unspecified order
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @tparam Fn function type
+     * @param policy execution policy
+     * @param map bidirectional_map
+     * @param fn function that is called with const references to both keys of each item
+     * @throws the first exception thrown by fn
+     */
+    template<typename ExecutionPolicy, typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType, template<typename ...> typename InverseMapType,
+             typename LatencyPolicy, typename Fn>
+    auto for_each(ExecutionPolicy &&policy,
+                  const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &map,
+                  Fn fn)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>> {
+        impl::for_each_chunk(impl::BaseAccess::forward(map), impl::concurrency_for(policy), [&fn](auto &&visit) {
+            visit([&fn](const auto &it) { fn(it->first, *it->second); });
+        });
+    }
+
+    /**
+     * Counts the items for which pred(forwardKey, inverseKey) is true. With a parallel execution policy pred is
+     * called concurrently from multiple threads
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @tparam Pred predicate type
+     * @param policy execution policy
+     * @param map bidirectional_map
+     * @param pred predicate that is called with const references to both keys of each item
+     * @return number of items satisfying pred
+     * @throws the first exception thrown by pred
+     */
+    template<typename ExecutionPolicy, typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType, template<typename ...> typename InverseMapType,
+             typename LatencyPolicy, typename Pred>
+    auto count_if(ExecutionPolicy &&policy,
+                  const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &map,
+                  Pred pred)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>, std::size_t> {
+        std::atomic<std::size_t> count{0};
+        impl::for_each_chunk(impl::BaseAccess::forward(map), impl::concurrency_for(policy),
+                             [&pred, &count](auto &&visit) {
+                                 std::size_t local = 0;
+                                 visit([&pred, &local](const auto &it) {
+                                     local += static_cast<bool>(pred(it->first, *it->second));
+                                 });
+
+                                 count += local;
+                             });
+
+        return count;
+    }
+
+    /**
+     * Erases all items for which pred(forwardKey, inverseKey) is true from both lookup directions. With a parallel
+     * execution policy, pred is evaluated concurrently from multiple threads. The matching items are erased
+     * afterwards by the calling thread, such that forward and inverse base containers stay consistent
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @tparam Pred predicate type
+     * @param policy execution policy
+     * @param map bidirectional_map
+     * @param pred predicate that is called with const references to both keys of each item
+     * @return number of erased items
+     * @throws the first exception thrown by pred. No items are erased in that case
+     */
+    template<typename ExecutionPolicy, typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType, template<typename ...> typename InverseMapType,
+             typename LatencyPolicy, typename Pred>
+    auto erase_if(ExecutionPolicy &&policy,
+                  bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &map,
+                  Pred pred)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>, std::size_t> {
+        using BiMap = bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy>;
+        const auto &base = impl::BaseAccess::forward(std::as_const(map));
+        using Iterator = decltype(base.begin());
+        std::vector<Iterator> matches;
+        std::mutex mutex;
+        impl::for_each_chunk(base, impl::concurrency_for(policy), [&](auto &&visit) {
+            std::vector<Iterator> local;
+            visit([&](const auto &it) {
+                if (!pred(it->first, *it->second)) {
+                    return;
+                }
+
+                if constexpr (std::is_same_v<std::decay_t<decltype(it)>, Iterator>) {
+                    local.emplace_back(it);
+                } else {
+                    // bucket iterators cannot be used for erasure, look up the corresponding container iterator
+                    auto candidate = base.equal_range(it->first).first;
+                    while (&*candidate != &*it) {
+                        ++candidate;
+                    }
+
+                    local.emplace_back(candidate);
+                }
+            });
+
+            if (!local.empty()) {
+                std::lock_guard lock(mutex);
+                matches.insert(matches.end(), local.begin(), local.end());
+            }
+        });
+
+        for (const auto &it : matches) {
+            map.erase(typename BiMap::iterator(it));
+        }
+
+        return matches.size();
+    }
+
+    /**
+     * @brief Items of two maps that share the same key but map to different values
+     */
+    template<typename Key, typename Value>
+    struct conflict {
+        Key key;
+        Value lhs; ///< value in the left hand side map
+        Value rhs; ///< value in the right hand side map
+    };
+
+    /**
+     * @brief Result of a set operation on two bidirectional_maps
+     */
+    template<typename ForwardKey, typename InverseKey, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy = no_latency_policy>
+    struct set_result {
+        /// resulting map
+        bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> map;
+        /// items with equal forward keys but different inverse keys
+        std::vector<conflict<ForwardKey, InverseKey>> conflicts;
+        /// items with equal inverse keys but different forward keys (only reported by merge_union)
+        std::vector<conflict<InverseKey, ForwardKey>> inverse_conflicts;
+    };
+
+    /**
+     * Union of two maps. All items of lhs are kept. Items of rhs are added if neither their forward key nor their
+     * inverse key is already contained in lhs. Otherwise, they are reported as conflicts (unless the same item is
+     * contained in both maps)
+     * @param lhs left hand side
+     * @param rhs right hand side
+     * @return set_result containing the union and the conflicting items
+     * @note Both base containers must have unique keys. Ordered base containers are merged in linear time
+     */
+    template<typename ForwardKey, typename InverseKey, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy>
+    auto merge_union(
+            const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &lhs,
+            const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &rhs)
+    -> set_result<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> {
+        static_assert(impl::traits::has_unique_keys<std::decay_t<decltype(lhs)>>,
+                      "set operations require unique keys in both lookup directions");
+        set_result<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> ret{lhs, {}, {}};
+        impl::try_reserve(ret.map, lhs.size() + rhs.size());
+        impl::merge_walk<false, true>(lhs, rhs, [&ret](const auto &key, const auto &lhsVal, const auto &rhsVal) {
+            if (!(lhsVal == rhsVal)) {
+                ret.conflicts.push_back({key, lhsVal, rhsVal});
+            }
+        }, [](const auto &, const auto &) {}, [&ret](const auto &key, const auto &value) {
+            auto [it, inserted] = ret.map.emplace(key, value);
+            if (!inserted) {
+                ret.inverse_conflicts.push_back({value, it->first, key});
+            }
+        });
+
+        return ret;
+    }
+
+    /**
+     * Intersection of two maps. Contains all items that are contained in both maps.
+     * @param lhs left hand side
+     * @param rhs right hand side
+     * @return set_result containing the intersection and the items with equal forward keys but different inverse keys
+     * @note Both base containers must have unique keys. Ordered base containers are merged in linear time, otherwise
+     * the smaller map is used for probing
+     */
+    template<typename ForwardKey, typename InverseKey, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy>
+    auto intersect(const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &lhs,
+                   const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &rhs)
+    -> set_result<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> {
+        static_assert(impl::traits::has_unique_keys<std::decay_t<decltype(lhs)>>,
+                      "set operations require unique keys in both lookup directions");
+        set_result<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> ret;
+        impl::try_reserve(ret.map, std::min(lhs.size(), rhs.size()));
+        impl::merge_walk<false, false>(lhs, rhs, [&ret](const auto &key, const auto &lhsVal, const auto &rhsVal) {
+            if (lhsVal == rhsVal) {
+                ret.map.emplace(key, lhsVal);
+            } else {
+                ret.conflicts.push_back({key, lhsVal, rhsVal});
+            }
+        }, [](const auto &, const auto &) {}, [](const auto &, const auto &) {});
+        return ret;
+    }
+
+    /**
+     * Difference of two maps. Contains all items of lhs that are not contained in rhs.
+     * @param lhs left hand side
+     * @param rhs right hand side
+     * @return set_result containing the difference and the items with equal forward keys but different inverse keys.
+     * Note that these items are part of the difference
+     * @note Both base containers must have unique keys. Ordered base containers are merged in linear time
+     */
+    template<typename ForwardKey, typename InverseKey, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy>
+    auto difference(const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &lhs,
+                    const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &rhs)
+    -> set_result<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> {
+        static_assert(impl::traits::has_unique_keys<std::decay_t<decltype(lhs)>>,
+                      "set operations require unique keys in both lookup directions");
+        set_result<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> ret;
+        impl::try_reserve(ret.map, lhs.size());
+        impl::merge_walk<true, false>(lhs, rhs, [&ret](const auto &key, const auto &lhsVal, const auto &rhsVal) {
+            if (!(lhsVal == rhsVal)) {
+                ret.map.emplace(key, lhsVal);
+                ret.conflicts.push_back({key, lhsVal, rhsVal});
+            }
+        }, [&ret](const auto &key, const auto &value) {
+            ret.map.emplace(key, value);
+        }, [](const auto &, const auto &) {});
+        return ret;
+    }
+
+    /**
+     * Composes two maps A <-> B and B <-> C to a map A <-> C that contains (a, c) for every (a, b) in first and
+     * (b, c) in second. Items of first whose inverse key is not contained in second are skipped.
+     * @param first map A <-> B
+     * @param second map B <-> C
+     * @return map A <-> C using the forward base container of first and the inverse base container of second
+     */
+    template<typename A, typename B, typename C, template<typename ...> typename AMapType,
+             template<typename ...> typename BMapType1, template<typename ...> typename BMapType2,
+             template<typename ...> typename CMapType, typename LatencyPolicy>
+    auto compose(const bidirectional_map<A, B, AMapType, BMapType1, LatencyPolicy> &first,
+                 const bidirectional_map<B, C, BMapType2, CMapType, LatencyPolicy> &second)
+    -> bidirectional_map<A, C, AMapType, CMapType, LatencyPolicy> {
+        bidirectional_map<A, C, AMapType, CMapType, LatencyPolicy> ret;
+        impl::try_reserve(ret, std::min(first.size(), second.size()));
+        for (const auto &[a, b] : first) {
+            for (auto [curr, last] = second.equal_range(b); curr != last; ++curr) {
+                ret.emplace(a, curr->second);
+            }
+        }
+
+        return ret;
+    }
+
+    /**
+     * Parallel version of compose. With a parallel execution policy, the lookups in second are distributed over
+     * multiple threads. The resulting map is filled afterwards by the calling thread
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @param policy execution policy
+     * @param first map A <-> B
+     * @param second map B <-> C
+     * @return map A <-> C using the forward base container of first and the inverse base container of second
+     */
+    template<typename ExecutionPolicy, typename A, typename B, typename C, template<typename ...> typename AMapType,
+             template<typename ...> typename BMapType1, template<typename ...> typename BMapType2,
+             template<typename ...> typename CMapType, typename LatencyPolicy>
+    auto compose(ExecutionPolicy &&policy, const bidirectional_map<A, B, AMapType, BMapType1, LatencyPolicy> &first,
+                 const bidirectional_map<B, C, BMapType2, CMapType, LatencyPolicy> &second)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>,
+                        bidirectional_map<A, C, AMapType, CMapType, LatencyPolicy>> {
+        if constexpr (!impl::traits::is_parallel_policy<ExecutionPolicy>) {
+            return compose(first, second);
+        } else {
+            std::vector<std::pair<const A *, const C *>> matches;
+            matches.reserve(std::min(first.size(), second.size()));
+            std::mutex mutex;
+            impl::for_each_chunk(impl::BaseAccess::forward(first), impl::concurrency_for(policy),
+                                 [&second, &matches, &mutex](auto &&visit) {
+                                     std::vector<std::pair<const A *, const C *>> local;
+                                     visit([&second, &local](const auto &it) {
+                                         for (auto [curr, last] = second.equal_range(*it->second); curr != last;
+                                              ++curr) {
+                                             local.emplace_back(&it->first, &curr->second);
+                                         }
+                                     });
+
+                                     std::lock_guard lock(mutex);
+                                     matches.insert(matches.end(), local.begin(), local.end());
+                                 });
+
+            bidirectional_map<A, C, AMapType, CMapType, LatencyPolicy> ret;
+            impl::try_reserve(ret, matches.size());
+            for (auto [a, c] : matches) {
+                ret.emplace(*a, *c);
+            }
+
+            return ret;
+        }
+    }
+
+    /**
+     * @brief Non owning view of the composition of two maps A <-> B and B <-> C that resolves lookups through both
+     * maps on demand.
+     * @details The view does not copy any elements. Lookups cost one lookup in each map. The referenced maps must
+     * outlive the view. Both maps must have unique keys in both lookup directions.
+     * @tparam First bidirectional_map type A <-> B
+     * @tparam Second bidirectional_map type B <-> C
+     */
+    template<typename First, typename Second>
+    class composed_view {
+        using ForwardKey = std::decay_t<typename First::iterator::value_type::first_type>;
+        using InverseKey = std::decay_t<typename Second::iterator::value_type::second_type>;
+        static_assert(impl::traits::has_unique_keys<First> && impl::traits::has_unique_keys<Second>,
+                      "composed_view requires unique keys in both lookup directions");
+    public:
+        /**
+         * CTor
+         * @param first map A <-> B
+         * @param second map B <-> C
+         */
+        constexpr composed_view(const First &first, const Second &second) noexcept: first(&first), second(&second) {}
+
+        /**
+         * Whether the key can be resolved through both maps
+         * @param key key used for lookup
+         * @return true if first contains (key, b) and second contains (b, c)
+         */
+        bool contains(const ForwardKey &key) const {
+            auto res = first->find(key);
+            return res != first->end() && second->contains(res->second);
+        }
+
+        /**
+         * Resolves the key through both maps
+         * @param key key used for lookup
+         * @return reference to the value in second
+         * @throws out_of_range if key cannot be resolved
+         */
+        const InverseKey &at(const ForwardKey &key) const {
+            auto res = first->find(key);
+            if (res != first->end()) {
+                if (auto secondRes = second->find(res->second); secondRes != second->end()) {
+                    return secondRes->second;
+                }
+            }
+
+            throw std::out_of_range("composed view key not found");
+        }
+
+        /**
+         * Inverse view C <-> A
+         * @return view resolving through the inverse maps of second and first
+         */
+        auto inverse() const noexcept {
+            return composed_view<std::decay_t<decltype(second->inverse())>,
+                                 std::decay_t<decltype(first->inverse())>>(second->inverse(), first->inverse());
+        }
+
+        /**
+         * Creates a map containing all items of the view
+         * @return map A <-> C
+         */
+        auto materialize() const {
+            return compose(*first, *second);
+        }
+
+    private:
+        const First *first;
+        const Second *second;
+    };
+
+    /**
+     * @brief Set of erasures and insertions that turns one bidirectional_map into another one
+     * @details Erasures have to be applied before insertions, see bidirectional_map::apply
+     */
+    template<typename ForwardKey, typename InverseKey>
+    struct changeset {
+        std::vector<std::pair<ForwardKey, InverseKey>> erasures;
+        std::vector<std::pair<ForwardKey, InverseKey>> insertions;
+
+        /**
+         * Whether the changeset does not contain any changes
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return erasures.empty() && insertions.empty();
+        }
+    };
+
+    /**
+     * Computes the minimal changeset that turns from into to. Every item that is only contained in from is erased and
+     * every item that is only contained in to is inserted.
+     * @param from source map
+     * @param to target map
+     * @return changeset such that from.apply(changeset) results in a map equal to to
+     * @note Both base containers must have unique keys. Ordered base containers are merged in a single pass,
+     * otherwise the keys of each map are looked up once in the other map
+     */
+    template<typename ForwardKey, typename InverseKey, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy>
+    auto diff(const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &from,
+              const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &to)
+    -> changeset<ForwardKey, InverseKey> {
+        static_assert(impl::traits::has_unique_keys<std::decay_t<decltype(from)>>,
+                      "diff requires unique keys in both lookup directions");
+        changeset<ForwardKey, InverseKey> ret;
+        impl::merge_walk<true, true>(from, to, [&ret](const auto &key, const auto &fromVal, const auto &toVal) {
+            if (!(fromVal == toVal)) {
+                ret.erasures.emplace_back(key, fromVal);
+                ret.insertions.emplace_back(key, toVal);
+            }
+        }, [&ret](const auto &key, const auto &value) {
+            ret.erasures.emplace_back(key, value);
+        }, [&ret](const auto &key, const auto &value) {
+            ret.insertions.emplace_back(key, value);
+        });
+
+        return ret;
+    }
+
+    /**
+     * Parallel version of diff. With a parallel execution policy, each map is probed with the items of the other map
+     * using multiple threads. The order of the items within the changeset is unspecified in that case
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @param policy execution policy
+     * @param from source map
+     * @param to target map
+     * @return changeset such that from.apply(changeset) results in a map equal to to
+     */
+    template<typename ExecutionPolicy, typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType, template<typename ...> typename InverseMapType,
+             typename LatencyPolicy>
+    auto diff(ExecutionPolicy &&policy,
+              const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &from,
+              const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &to)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>, changeset<ForwardKey, InverseKey>> {
+        if constexpr (!impl::traits::is_parallel_policy<ExecutionPolicy>) {
+            return diff(from, to);
+        } else {
+            static_assert(impl::traits::has_unique_keys<std::decay_t<decltype(from)>>,
+                          "diff requires unique keys in both lookup directions");
+            const auto numThreads = impl::concurrency_for(policy);
+            changeset<ForwardKey, InverseKey> ret;
+            auto erasures = impl::missing_items<std::decay_t<decltype(from)>, ForwardKey, InverseKey>(from, to,
+                                                                                                    numThreads);
+            auto insertions = impl::missing_items<std::decay_t<decltype(from)>, ForwardKey, InverseKey>(to, from,
+                                                                                                      numThreads);
+            ret.erasures.reserve(erasures.size());
+            for (auto [key, value] : erasures) {
+                ret.erasures.emplace_back(*key, *value);
+            }
+
+            ret.insertions.reserve(insertions.size());
+            for (auto [key, value] : insertions) {
+                ret.insertions.emplace_back(*key, *value);
+            }
+
+            return ret;
+        }
+    }
+
+    /**
+     * Copies the contents of the map into two columns such that (forwardOut[i], inverseOut[i]) is the i-th item of the
+     * map. With a parallel execution policy, the base container is split into chunks (bucket ranges for unordered
+     * containers) that are copied concurrently. The order of items is the same as for sequential execution if the
+     * forward base container is ordered
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @tparam ForwardOut random access iterator type of the forward key column, e.g. ForwardKey *
+     * @tparam InverseOut random access iterator type of the inverse key column, e.g. InverseKey *
+     * @param policy execution policy
+     * @param map bidirectional_map
+     * @param forwardOut begin of the forward key column. Must hold at least map.size() elements that are assigned
+     * @param inverseOut begin of the inverse key column. Must hold at least map.size() elements that are assigned
+     * @return number of exported items
+     */
+    template<typename ExecutionPolicy, typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType, template<typename ...> typename InverseMapType,
+             typename LatencyPolicy, typename ForwardOut, typename InverseOut>
+    auto export_columns(
+            ExecutionPolicy &&policy,
+            const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &map,
+            ForwardOut forwardOut, InverseOut inverseOut)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>, std::size_t> {
+        const auto &base = impl::BaseAccess::forward(map);
+        const auto numThreads = impl::concurrency_for(policy);
+        impl::Chunks<std::decay_t<decltype(base)>> chunks(base, numThreads);
+        std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+        if (chunks.size() > 1) {
+            impl::parallel_for(chunks.size(), [&chunks, &offsets](std::size_t chunk) {
+                std::size_t count = 0;
+                chunks.for_each_range(chunk, [&count](auto first, auto last) {
+                    count += static_cast<std::size_t>(std::distance(first, last));
+                });
+
+                offsets[chunk + 1] = count;
+            }, numThreads);
+
+            for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+                offsets[chunk + 1] += offsets[chunk];
+            }
+        }
+
+        impl::parallel_for(chunks.size(), [&](std::size_t chunk) {
+            auto pos = offsets[chunk];
+            chunks.for_each_range(chunk, [&](auto first, auto last) {
+                pos += impl::copy_columns(first, last, forwardOut + pos, inverseOut + pos);
+            });
+        }, numThreads);
+
+        return map.size();
+    }
+
+    /**
+     * Sequential version of export_columns
+     * @param map bidirectional_map
+     * @param forwardOut begin of the forward key column. Must hold at least map.size() elements that are assigned
+     * @param inverseOut begin of the inverse key column. Must hold at least map.size() elements that are assigned
+     * @return number of exported items
+     */
+    template<typename ForwardKey, typename InverseKey, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy, typename ForwardOut,
+             typename InverseOut>
+    std::size_t export_columns(
+            const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &map,
+            ForwardOut forwardOut, InverseOut inverseOut) {
+        return export_columns(std::execution::seq, map, forwardOut, inverseOut);
+    }
+
+    /**
+     * Same as export_columns but the columns are sorted by forward key. If the forward base container is ordered,
+     * its order is used. Otherwise, the items are sorted using std::less<>
+     * @param policy execution policy
+     * @param map bidirectional_map
+     * @param forwardOut begin of the forward key column. Must hold at least map.size() elements that are assigned
+     * @param inverseOut begin of the inverse key column. Must hold at least map.size() elements that are assigned
+     * @return number of exported items
+     */
+    template<typename ExecutionPolicy, typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType, template<typename ...> typename InverseMapType,
+             typename LatencyPolicy, typename ForwardOut, typename InverseOut>
+    auto export_sorted_columns(
+            ExecutionPolicy &&policy,
+            const bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &map,
+            ForwardOut forwardOut, InverseOut inverseOut)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>, std::size_t> {
+        using Base = std::decay_t<decltype(impl::BaseAccess::forward(map))>;
+        if constexpr (impl::traits::is_ordered<Base>::value) {
+            return export_columns(std::forward<ExecutionPolicy>(policy), map, forwardOut, inverseOut);
+        } else {
+            std::vector<std::pair<const ForwardKey *, const InverseKey *>> items(map.size());
+            std::atomic<std::size_t> pos{0};
+            impl::for_each_chunk(impl::BaseAccess::forward(map), impl::concurrency_for(policy),
+                                 [&items, &pos](auto &&visit) {
+                                     std::vector<std::pair<const ForwardKey *, const InverseKey *>> local;
+                                     visit([&local](const auto &it) {
+                                         local.emplace_back(&it->first, &*it->second);
+                                     });
+
+                                     std::copy(local.begin(), local.end(), items.begin() + pos.fetch_add(local.size()));
+                                 });
+
+            std::sort(items.begin(), items.end(), [](const auto &lhs, const auto &rhs) {
+                return std::less<>{}(*lhs.first, *rhs.first);
+            });
+
+            for (const auto &[key, value] : items) {
+                *forwardOut = *key;
+                *inverseOut = *value;
+                ++forwardOut;
+                ++inverseOut;
+            }
+
+            return items.size();
+        }
+    }
+}
+
+#endif //BIDIRECTIONALMAP_ALGORITHMS_HPP
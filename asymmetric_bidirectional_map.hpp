@@ -0,0 +1,579 @@
+/**
+ * @file asymmetric_bidirectional_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a bidirectional map with hash based forward lookup and a lazily merged sorted array for
+ * inverse lookup.
+ */
+
+#ifndef BIDIRECTIONALMAP_ASYMMETRIC_BIDIRECTIONAL_MAP_HPP
+#define BIDIRECTIONALMAP_ASYMMETRIC_BIDIRECTIONAL_MAP_HPP
+
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Bidirectional map for frequent forward insertions and occasional inverse range queries.
+     * @details Forward lookup uses a hash map. Inverse lookup uses an array of (inverse key, forward key pointer)
+     * pairs sorted by inverse key plus a small unsorted tail of recently inserted pairs. Insertion appends to the
+     * tail in O(1). Once the tail exceeds MinTail pairs and 1 / TailFraction of the sorted array, it is sorted and
+     * merged into the array, which is O(1) amortized per insertion up to the sorting of the tail. Erasure of merged
+     * pairs leaves tombstones that are removed on the next merge. Every inverse query merges first, so it operates
+     * on a plain sorted array.
+     * Forward keys are always unique. Uniqueness of inverse keys is checked during merges: a tail pair whose inverse
+     * key is already contained is removed from the map, exactly as emplace on a bidirectional_map would have
+     * rejected it. merge() returns all pairs rejected since its last call.
+     * ```
+     * bimap::asymmetric_bidirectional_map<std::string, int> map;
+     * map.emplace("a", 3);
+     * map.emplace("b", 1);
+     * auto it = map.inverse().lower_bound(2); // (3, "a")
+     * ```
+     * @tparam ForwardKey type of forward keys
+     * @tparam InverseKey type of inverse keys. Inverse keys are stored twice, so they must be copy constructible
+     * @tparam ForwardMapType container used for forward lookup. Must not be a multimap and must not invalidate
+     * references to its elements on insertion
+     * @tparam InverseCompare comparator used to order the inverse keys
+     */
+    template<typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType = std::unordered_map,
+             typename InverseCompare = std::less<InverseKey>>
+    class asymmetric_bidirectional_map {
+        static constexpr std::size_t Merged = std::numeric_limits<std::size_t>::max();
+
+        struct Entry {
+            template<typename ...ARGS>
+            explicit Entry(ARGS &&...args) : value(std::forward<ARGS>(args)...) {}
+
+            InverseKey value;
+            // position in the tail or Merged
+            std::size_t tailPos = Merged;
+        };
+
+        using ForwardMap = ForwardMapType<ForwardKey, Entry>;
+        using Node = typename ForwardMap::value_type;
+        // erased pairs are marked by a nullptr
+        using SortedItem = std::pair<InverseKey, const ForwardKey *>;
+        static_assert(!impl::traits::is_multimap_v<ForwardMap>,
+                      "asymmetric_bidirectional_map does not support multimaps");
+
+        template<typename BaseIt, bool Inverse>
+        class Iterator {
+            friend class asymmetric_bidirectional_map;
+            using Key = std::conditional_t<Inverse, InverseKey, ForwardKey>;
+            using Value = std::conditional_t<Inverse, ForwardKey, InverseKey>;
+        public:
+            using value_type = std::pair<const Key &, const Value &>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = typename std::iterator_traits<BaseIt>::difference_type;
+            using iterator_category = std::conditional_t<Inverse, std::bidirectional_iterator_tag,
+                                                         typename std::iterator_traits<BaseIt>::iterator_category>;
+
+            Iterator() = default;
+
+            explicit Iterator(BaseIt it) : it(it) {}
+
+            reference operator*() const {
+                if constexpr (Inverse) {
+                    return {it->first, *it->second};
+                } else {
+                    return {it->first, it->second.value};
+                }
+            }
+
+            pointer operator->() const {
+                return {**this};
+            }
+
+            Iterator &operator++() {
+                ++it;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto tmp = *this;
+                ++it;
+                return tmp;
+            }
+
+            Iterator &operator--() {
+                --it;
+                return *this;
+            }
+
+            Iterator operator--(int) {
+                auto tmp = *this;
+                --it;
+                return tmp;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return it == other.it;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return it != other.it;
+            }
+
+        private:
+            BaseIt it;
+        };
+
+        struct KeyCompare {
+            bool operator()(const SortedItem &lhs, const SortedItem &rhs) const {
+                return InverseCompare{}(lhs.first, rhs.first);
+            }
+
+            bool operator()(const SortedItem &lhs, const InverseKey &rhs) const {
+                return InverseCompare{}(lhs.first, rhs);
+            }
+
+            bool operator()(const InverseKey &lhs, const SortedItem &rhs) const {
+                return InverseCompare{}(lhs, rhs.first);
+            }
+        };
+
+    public:
+        /**
+         * Minimum size of the unsorted tail before it is merged automatically
+         */
+        static constexpr std::size_t MinTail = 64;
+
+        /**
+         * The tail is merged automatically once it is larger than the sorted array divided by this number
+         */
+        static constexpr std::size_t TailFraction = 8;
+
+        using iterator = Iterator<typename ForwardMap::const_iterator, false>;
+        using inverse_iterator = Iterator<typename std::vector<SortedItem>::const_iterator, true>;
+
+        /**
+         * @brief Ordered inverse lookup of a merged asymmetric_bidirectional_map. Valid until the map is modified
+         */
+        class inverse_view {
+        public:
+            explicit inverse_view(const asymmetric_bidirectional_map &map) noexcept: map(&map) {}
+
+            inverse_iterator begin() const {
+                return inverse_iterator(map->sorted.begin());
+            }
+
+            inverse_iterator end() const {
+                return inverse_iterator(map->sorted.end());
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                return map->sorted.size();
+            }
+
+            [[nodiscard]] bool empty() const noexcept {
+                return map->sorted.empty();
+            }
+
+            /**
+             * Binary search for an inverse key
+             * @param key key used for lookup
+             * @return iterator to the found pair or end() if key cannot be found
+             */
+            inverse_iterator find(const InverseKey &key) const {
+                auto res = lower_bound(key);
+                return res != end() && !InverseCompare{}(key, res->first) ? res : end();
+            }
+
+            /**
+             * @copydoc asymmetric_bidirectional_map::contains
+             */
+            bool contains(const InverseKey &key) const {
+                return find(key) != end();
+            }
+
+            /**
+             * @copydoc asymmetric_bidirectional_map::at
+             */
+            const ForwardKey &at(const InverseKey &key) const {
+                auto res = find(key);
+                if (res == end()) {
+                    throw std::out_of_range("asymmetric bidirectional map key not found");
+                }
+
+                return res->second;
+            }
+
+            /**
+             * First pair whose inverse key is not less than key
+             */
+            inverse_iterator lower_bound(const InverseKey &key) const {
+                return inverse_iterator(std::lower_bound(map->sorted.begin(), map->sorted.end(), key, KeyCompare{}));
+            }
+
+            /**
+             * First pair whose inverse key is greater than key
+             */
+            inverse_iterator upper_bound(const InverseKey &key) const {
+                return inverse_iterator(std::upper_bound(map->sorted.begin(), map->sorted.end(), key, KeyCompare{}));
+            }
+
+            /**
+             * Access to forward lookup
+             */
+            const asymmetric_bidirectional_map &inverse() const noexcept {
+                return *map;
+            }
+
+        private:
+            const asymmetric_bidirectional_map *map;
+        };
+
+        asymmetric_bidirectional_map() = default;
+
+        /**
+         * Copy constructor. Unmerged pairs stay unmerged
+         * @param other source
+         */
+        asymmetric_bidirectional_map(const asymmetric_bidirectional_map &other)
+                : forwardMap(other.forwardMap), sorted(other.sorted), tail(other.tail.size()),
+                  rejected(other.rejected), numTail(other.numTail), numTombstones(other.numTombstones) {
+            for (auto &item : sorted) {
+                if (item.second != nullptr) {
+                    item.second = &forwardMap.find(*item.second)->first;
+                }
+            }
+
+            for (auto &node : forwardMap) {
+                if (node.second.tailPos != Merged) {
+                    tail[node.second.tailPos] = &node;
+                }
+            }
+        }
+
+        asymmetric_bidirectional_map(asymmetric_bidirectional_map &&) noexcept = default;
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to *this
+         */
+        asymmetric_bidirectional_map &operator=(const asymmetric_bidirectional_map &other) {
+            if (this != &other) {
+                *this = asymmetric_bidirectional_map(other);
+            }
+
+            return *this;
+        }
+
+        asymmetric_bidirectional_map &operator=(asymmetric_bidirectional_map &&) noexcept = default;
+
+        iterator begin() const {
+            return iterator(forwardMap.begin());
+        }
+
+        iterator end() const {
+            return iterator(forwardMap.end());
+        }
+
+        /**
+         * Number of contained pairs including unmerged pairs
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return forwardMap.size();
+        }
+
+        /**
+         * Whether the map is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return forwardMap.empty();
+        }
+
+        /**
+         * Whether the sorted inverse array is up to date, i.e. there is neither a tail nor a tombstone
+         */
+        [[nodiscard]] bool merged() const noexcept {
+            return numTail == 0 && numTombstones == 0;
+        }
+
+        /**
+         * Inserts a pair if the forward key is not already contained. Uniqueness of the inverse key is only checked
+         * by the next merge
+         * @param forwardKey forward key
+         * @param inverseKey inverse key
+         * @return std::pair(iterator to inserted element or already existing element, bool whether insertion happened)
+         */
+        template<typename K1, typename K2>
+        auto emplace(K1 &&forwardKey, K2 &&inverseKey) -> std::pair<iterator, bool> {
+            auto [it, inserted] = forwardMap.try_emplace(std::forward<K1>(forwardKey), std::forward<K2>(inverseKey));
+            if (inserted) {
+                it->second.tailPos = tail.size();
+                try {
+                    tail.emplace_back(&*it);
+                } catch (...) {
+                    forwardMap.erase(it);
+                    throw;
+                }
+
+                ++numTail;
+                if (numTail > std::max(MinTail, sorted.size() / TailFraction)) {
+                    if (auto conflict = mergeTail(&*it); conflict != nullptr) {
+                        return {find(*conflict), false};
+                    }
+                }
+            }
+
+            return {iterator(it), inserted};
+        }
+
+        /**
+         * Finds the pair with the given forward key
+         * @param key key used for lookup
+         * @return iterator to the found pair or end() if key cannot be found
+         */
+        iterator find(const ForwardKey &key) const {
+            return iterator(forwardMap.find(key));
+        }
+
+        /**
+         * Check if a certain key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        bool contains(const ForwardKey &key) const {
+            return find(key) != end();
+        }
+
+        /**
+         * Returns the value found by the given key
+         * @param key key used for lookup
+         * @return reference to found value
+         * @throws std::out_of_range if key does not exist
+         */
+        const InverseKey &at(const ForwardKey &key) const {
+            auto res = find(key);
+            if (res == end()) {
+                throw std::out_of_range("asymmetric bidirectional map key not found");
+            }
+
+            return res->second;
+        }
+
+        /**
+         * Erases the pair with the given forward key. Unmerged pairs leave a tombstone in the tail, which keeps the
+         * remaining tail in insertion order, in amortized O(1). Merged pairs are marked as erased in O(log n)
+         * @param key key of the pair to erase
+         * @return number of erased pairs (0 or 1)
+         */
+        std::size_t erase(const ForwardKey &key) {
+            auto it = forwardMap.find(key);
+            if (it == forwardMap.end()) {
+                return 0;
+            }
+
+            if (const auto pos = it->second.tailPos; pos != Merged) {
+                tail[pos] = nullptr;
+                --numTail;
+                if (tail.size() > MinTail && tail.size() > 2 * numTail) {
+                    compactTail();
+                }
+            } else {
+                auto [first, last] = std::equal_range(sorted.begin(), sorted.end(), it->second.value, KeyCompare{});
+                std::find_if(first, last, [](const auto &item) { return item.second != nullptr; })->second = nullptr;
+                ++numTombstones;
+            }
+
+            forwardMap.erase(it);
+            return 1;
+        }
+
+        /**
+         * Erases all pairs
+         */
+        void clear() noexcept {
+            tail.clear();
+            numTail = 0;
+            sorted.clear();
+            forwardMap.clear();
+            numTombstones = 0;
+        }
+
+        /**
+         * Sorts the tail, merges it into the sorted inverse array and removes tombstones. If copying an inverse key or
+         * comparing throws, the map is unchanged. If storing a rejected pair throws, the rejected pairs processed so
+         * far are lost and the remaining conflicting pairs stay unmerged
+         * @return pairs that were removed because their inverse key was not unique since the last call to merge, in
+         * insertion order
+         */
+        std::vector<std::pair<ForwardKey, InverseKey>> merge() {
+            mergeTail();
+            return std::exchange(rejected, {});
+        }
+
+        /**
+         * Access to inverse lookup. Calls merge first, pairs rejected by merge are discarded
+         * @return view for ordered lookup from inverse keys to forward keys
+         */
+        inverse_view inverse() {
+            merge();
+            return inverse_view(*this);
+        }
+
+        /**
+         * Access to inverse lookup of a merged map
+         * @return view for ordered lookup from inverse keys to forward keys
+         * @throws std::logic_error if the map is not merged. Call merge first
+         */
+        inverse_view inverse() const {
+            if (!merged()) {
+                throw std::logic_error("asymmetric bidirectional map is not merged");
+            }
+
+            return inverse_view(*this);
+        }
+
+    private:
+        /**
+         * Merges the tail and removes tombstones. Pairs with duplicate inverse keys are moved to rejected, except for
+         * watch, which is erased
+         * @param watch optional node of the tail
+         * @return pointer to the forward key of the pair that conflicts with watch if watch was rejected, nullptr
+         * otherwise
+         */
+        const ForwardKey *mergeTail(const Node *watch = nullptr) {
+            if (numTail == 0 && numTombstones == 0) {
+                tail.clear();
+                return nullptr;
+            }
+
+            // stable sort keeps the first inserted pair of equal inverse keys
+            std::vector<std::pair<const InverseKey *, Node *>> newItems;
+            newItems.reserve(numTail);
+            for (auto node : tail) {
+                if (node != nullptr) {
+                    newItems.emplace_back(&node->second.value, node);
+                }
+            }
+
+            std::stable_sort(newItems.begin(), newItems.end(), [](const auto &lhs, const auto &rhs) {
+                return InverseCompare{}(*lhs.first, *rhs.first);
+            });
+
+            // the merged array is built in a temporary, so the map is unchanged if this part throws
+            std::vector<SortedItem> added;
+            std::vector<std::size_t> positions;
+            std::vector<Node *> accepted;
+            std::vector<Node *> duplicates;
+            added.reserve(newItems.size());
+            positions.reserve(newItems.size());
+            accepted.reserve(newItems.size());
+            duplicates.reserve(newItems.size());
+            const InverseKey *previous = nullptr;
+            for (auto [value, node] : newItems) {
+                auto [first, last] = std::equal_range(sorted.begin(), sorted.end(), *value, KeyCompare{});
+                const bool duplicate = (previous != nullptr && !InverseCompare{}(*previous, *value)) ||
+                                       std::any_of(first, last, [](const auto &item) {
+                                           return item.second != nullptr;
+                                       });
+                if (duplicate) {
+                    duplicates.emplace_back(node);
+                } else {
+                    added.emplace_back(*value, &node->first);
+                    positions.emplace_back(static_cast<std::size_t>(first - sorted.begin()));
+                    accepted.emplace_back(node);
+                    previous = value;
+                }
+            }
+
+            std::sort(duplicates.begin(), duplicates.end(), [](const Node *lhs, const Node *rhs) {
+                return lhs->second.tailPos < rhs->second.tailPos;
+            });
+            rejected.reserve(rejected.size() + duplicates.size());
+            std::vector<SortedItem> result;
+            result.reserve(sorted.size() - numTombstones + added.size());
+            // items of sorted are only moved if that cannot throw, otherwise they are copied and sorted stays intact
+            std::size_t next = 0;
+            for (std::size_t i = 0; i < sorted.size(); ++i) {
+                for (; next < added.size() && positions[next] == i; ++next) {
+                    result.emplace_back(std::move(added[next]));
+                }
+
+                if (sorted[i].second != nullptr) {
+                    result.emplace_back(std::move_if_noexcept(sorted[i]));
+                }
+            }
+
+            for (; next < added.size(); ++next) {
+                result.emplace_back(std::move(added[next]));
+            }
+
+            sorted.swap(result);
+            numTombstones = 0;
+            for (auto node : accepted) {
+                node->second.tailPos = Merged;
+            }
+
+            typename ForwardMap::node_type watched;
+            std::size_t done = 0;
+            try {
+                while (done < duplicates.size()) {
+                    auto node = duplicates[done];
+                    auto handle = forwardMap.extract(node->first);
+                    // the node is gone from the forward map even if storing the rejected pair fails
+                    ++done;
+                    if (node == watch) {
+                        watched = std::move(handle);
+                    } else {
+                        rejected.emplace_back(std::move(handle.key()), std::move(handle.mapped().value));
+                    }
+                }
+            } catch (...) {
+                // the remaining duplicates stay in the tail, in insertion order
+                tail.assign(duplicates.begin() + static_cast<std::ptrdiff_t>(done), duplicates.end());
+                compactTail();
+                numTail = tail.size();
+                throw;
+            }
+
+            tail.clear();
+            numTail = 0;
+            if (watched.empty()) {
+                return nullptr;
+            }
+
+            return std::lower_bound(sorted.begin(), sorted.end(), watched.mapped().value, KeyCompare{})->second;
+        }
+
+        /**
+         * Removes the tombstones from the tail, keeping the order of the remaining nodes
+         */
+        void compactTail() noexcept {
+            std::size_t target = 0;
+            for (auto node : tail) {
+                if (node != nullptr) {
+                    node->second.tailPos = target;
+                    tail[target++] = node;
+                }
+            }
+
+            tail.resize(target);
+        }
+
+        ForwardMap forwardMap;
+        std::vector<SortedItem> sorted;
+        // unmerged nodes in insertion order, erased unmerged nodes are nullptr
+        std::vector<Node *> tail;
+        std::vector<std::pair<ForwardKey, InverseKey>> rejected;
+        std::size_t numTail = 0;
+        std::size_t numTombstones = 0;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_ASYMMETRIC_BIDIRECTIONAL_MAP_HPP
@@ -0,0 +1,337 @@
+/**
+ * @file bidirectional_index_view.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a non owning bidirectional lookup structure over two externally owned key columns. Only
+ * row numbers are stored, keys are never copied.
+ */
+
+#ifndef BIDIRECTIONALMAP_BIDIRECTIONAL_INDEX_VIEW_HPP
+#define BIDIRECTIONALMAP_BIDIRECTIONAL_INDEX_VIEW_HPP
+
+#include <functional>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+namespace bimap {
+    /**
+     * Row number returned by index lookups if a key cannot be found
+     */
+    constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Hash index over a key column. Stores row numbers in an open addressing table with linear probing.
+     * @details Memory consumption is about two row numbers per row, independent of the key size.
+     * @tparam Key key type
+     * @tparam Hash hash function
+     * @tparam KeyEqual key equality comparator
+     */
+    template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    class hash_index {
+    public:
+        /**
+         * Builds the index
+         * @param column key column
+         * @param rows number of rows in the column
+         * @throws std::invalid_argument if the column contains duplicate keys
+         */
+        hash_index(const Key *column, std::size_t rows) : slots(capacityFor(rows), npos) {
+            const std::size_t mask = slots.size() - 1;
+            for (std::size_t row = 0; row < rows; ++row) {
+                for (std::size_t slot = home(column[row]);; slot = (slot + 1) & mask) {
+                    if (slots[slot] == npos) {
+                        slots[slot] = row;
+                        break;
+                    }
+
+                    if (KeyEqual{}(column[slots[slot]], column[row])) {
+                        throw std::invalid_argument("duplicate key in index column");
+                    }
+                }
+            }
+        }
+
+        /**
+         * Looks up a key
+         * @param column key column the index was built with
+         * @param key key to search for
+         * @return row of the key or npos if not found
+         */
+        std::size_t find(const Key *column, const Key &key) const {
+            const std::size_t mask = slots.size() - 1;
+            for (std::size_t slot = home(key); slots[slot] != npos; slot = (slot + 1) & mask) {
+                if (KeyEqual{}(column[slots[slot]], key)) {
+                    return slots[slot];
+                }
+            }
+
+            return npos;
+        }
+
+    private:
+        std::size_t capacityFor(std::size_t rows) noexcept {
+            std::size_t capacity = 8;
+            shift = 61;
+            while (capacity < 2 * rows) {
+                capacity *= 2;
+                --shift;
+            }
+
+            return capacity;
+        }
+
+        // fibonacci hashing spreads hash functions like the identity over all slots
+        std::size_t home(const Key &key) const {
+            const auto hash = static_cast<std::uint64_t>(Hash{}(key));
+            return static_cast<std::size_t>((hash * 0x9e3779b97f4a7c15ull) >> shift);
+        }
+
+        unsigned shift = 61;
+        std::vector<std::size_t> slots;
+    };
+
+    /**
+     * @brief Sorted index over a key column. Stores the row numbers ordered by key, lookup is done by binary search.
+     * @details Memory consumption is one row number per row, independent of the key size.
+     * @tparam Key key type
+     * @tparam Compare comparator used to order the keys
+     */
+    template<typename Key, typename Compare = std::less<Key>>
+    class sorted_index {
+    public:
+        /**
+         * Builds the index
+         * @param column key column
+         * @param rows number of rows in the column
+         * @throws std::invalid_argument if the column contains duplicate keys
+         */
+        sorted_index(const Key *column, std::size_t rows) : order(rows) {
+            for (std::size_t row = 0; row < rows; ++row) {
+                order[row] = row;
+            }
+
+            std::sort(order.begin(), order.end(), [column](std::size_t lhs, std::size_t rhs) {
+                return Compare{}(column[lhs], column[rhs]);
+            });
+
+            for (std::size_t i = 1; i < order.size(); ++i) {
+                if (!Compare{}(column[order[i - 1]], column[order[i]])) {
+                    throw std::invalid_argument("duplicate key in index column");
+                }
+            }
+        }
+
+        /**
+         * @copydoc hash_index::find
+         */
+        std::size_t find(const Key *column, const Key &key) const {
+            auto res = std::lower_bound(order.begin(), order.end(), key, [column](std::size_t row, const Key &k) {
+                return Compare{}(column[row], k);
+            });
+
+            if (res == order.end() || Compare{}(key, column[*res])) {
+                return npos;
+            }
+
+            return *res;
+        }
+
+        /**
+         * Rows sorted by key
+         * @return reference to the row numbers in key order
+         */
+        const std::vector<std::size_t> &rows() const noexcept {
+            return order;
+        }
+
+    private:
+        std::vector<std::size_t> order;
+    };
+
+    /**
+     * @brief Non owning bidirectional lookup structure over two externally owned columns of equal length.
+     * @details Row i of the forward column and row i of the inverse column form one pair. The view only owns two
+     * indexes containing row numbers, so no keys are copied and the memory consumption is proportional to the number
+     * of rows. Both columns must contain unique keys, must outlive the view and must not be modified while the view
+     * is used.
+     * ```
+     * std::vector<std::string> names = ...;
+     * std::vector<std::uint64_t> ids = ...;
+     * bimap::bidirectional_index_view view(names.data(), ids.data(), names.size());
+     * auto id = view.at("abc");
+     * auto &name = view.inverse().at(17);
+     * ```
+     * @tparam ForwardKey type of the forward key column
+     * @tparam InverseKey type of the inverse key column
+     * @tparam ForwardIndexType index used for forward lookup. Either hash_index (default) or sorted_index
+     * @tparam InverseIndexType index used for inverse lookup. Either hash_index (default) or sorted_index
+     */
+    template<typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardIndexType = hash_index,
+             template<typename ...> typename InverseIndexType = hash_index>
+    class bidirectional_index_view {
+        using ForwardIndex = ForwardIndexType<ForwardKey>;
+        using InverseIndex = InverseIndexType<InverseKey>;
+
+        /**
+         * @brief Lookup in one direction
+         */
+        template<typename Key, typename Value, typename Index>
+        class Direction {
+        public:
+            constexpr Direction(const Key *keys, const Value *values, std::size_t numRows,
+                                const Index &index) noexcept : keys(keys), values(values), numRows(numRows),
+                                                               index(&index) {}
+
+            /**
+             * Looks up the row of a key
+             * @param key key used for lookup
+             * @return row of the key or npos if the key cannot be found
+             */
+            std::size_t find(const Key &key) const {
+                return index->find(keys, key);
+            }
+
+            /**
+             * Check if a certain key can be found
+             * @param key key used for lookup
+             * @return true if key can be found, false otherwise
+             */
+            bool contains(const Key &key) const {
+                return find(key) != npos;
+            }
+
+            /**
+             * Returns the value in the same row as the key
+             * @param key key used for lookup
+             * @return reference to the value in the externally owned column
+             * @throws std::out_of_range if key does not exist
+             */
+            const Value &at(const Key &key) const {
+                auto row = find(key);
+                if (row == npos) {
+                    throw std::out_of_range("bidirectional index key not found");
+                }
+
+                return values[row];
+            }
+
+            /**
+             * Number of rows
+             */
+            [[nodiscard]] std::size_t size() const noexcept {
+                return numRows;
+            }
+
+        private:
+            const Key *keys;
+            const Value *values;
+            std::size_t numRows;
+            const Index *index;
+        };
+
+    public:
+        /**
+         * Lookup from inverse keys to forward keys
+         */
+        using inverse_view = Direction<InverseKey, ForwardKey, InverseIndex>;
+
+        /**
+         * Builds the indexes over the given columns
+         * @param forwardColumn pointer to the first forward key
+         * @param inverseColumn pointer to the first inverse key
+         * @param rows number of rows in both columns
+         * @throws std::invalid_argument if one of the columns contains duplicate keys
+         */
+        bidirectional_index_view(const ForwardKey *forwardColumn, const InverseKey *inverseColumn, std::size_t rows)
+                : forwardColumn(forwardColumn), inverseColumn(inverseColumn), rows(rows),
+                  forwardIndex(forwardColumn, rows), inverseIndex(inverseColumn, rows) {}
+
+        /**
+         * @copydoc Direction::find
+         */
+        std::size_t find(const ForwardKey &key) const {
+            return forward().find(key);
+        }
+
+        /**
+         * @copydoc Direction::contains
+         */
+        bool contains(const ForwardKey &key) const {
+            return forward().contains(key);
+        }
+
+        /**
+         * @copydoc Direction::at
+         */
+        const InverseKey &at(const ForwardKey &key) const {
+            return forward().at(key);
+        }
+
+        /**
+         * Number of rows
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return rows;
+        }
+
+        /**
+         * Whether the view is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return rows == 0;
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return lightweight view for lookup from inverse keys to forward keys. Valid as long as *this exists
+         */
+        inverse_view inverse() const noexcept {
+            return inverse_view(inverseColumn, forwardColumn, rows, inverseIndex);
+        }
+
+        /**
+         * Forward key column
+         */
+        const ForwardKey *forward_column() const noexcept {
+            return forwardColumn;
+        }
+
+        /**
+         * Inverse key column
+         */
+        const InverseKey *inverse_column() const noexcept {
+            return inverseColumn;
+        }
+
+        /**
+         * Access to the forward index, e.g. to iterate sorted_index::rows
+         */
+        const ForwardIndex &forward_index() const noexcept {
+            return forwardIndex;
+        }
+
+        /**
+         * Access to the inverse index, e.g. to iterate sorted_index::rows
+         */
+        const InverseIndex &inverse_index() const noexcept {
+            return inverseIndex;
+        }
+
+    private:
+        Direction<ForwardKey, InverseKey, ForwardIndex> forward() const noexcept {
+            return {forwardColumn, inverseColumn, rows, forwardIndex};
+        }
+
+        const ForwardKey *forwardColumn;
+        const InverseKey *inverseColumn;
+        std::size_t rows;
+        ForwardIndex forwardIndex;
+        InverseIndex inverseIndex;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_BIDIRECTIONAL_INDEX_VIEW_HPP
@@ -12,8 +12,12 @@
 
 #include <unordered_map>
 #include <map>
+#include <string>
+#include <vector>
 #include <stdexcept>
 #include <cassert>
+#include <cstdint>
+#include <functional>
 
 #define REQUIRES_THAT(TYPENAME, EXPRESSION) typename _T_ = TYPENAME, typename = std::void_t<decltype(EXPRESSION)>
 
@@ -68,8 +72,38 @@ namespace bimap::impl {
         template<typename T>
         constexpr inline bool is_multimap_v = is_multimap<T>::value;
 
+        template<typename T, typename = std::void_t<>>
+        struct has_reserve {
+            static constexpr bool value = false;
+        };
+
+        template<typename T>
+        struct has_reserve<T, std::void_t<decltype(std::declval<T &>().reserve(std::size_t{}))>> {
+            static constexpr bool value = true;
+        };
+
+        template<typename T, typename = std::void_t<>>
+        struct is_hashable {
+            static constexpr bool value = false;
+        };
+
+        template<typename T>
+        struct is_hashable<T, std::void_t<decltype(std::hash<T>{}(std::declval<const T &>()))>> {
+            static constexpr bool value = true;
+        };
+
         template<typename T>
         constexpr inline bool nothrow_comparable = noexcept(std::declval<T>() == std::declval<T>());
+
+        template<typename T, typename = std::void_t<>>
+        struct records_conflicts {
+            static constexpr bool value = false;
+        };
+
+        template<typename T>
+        struct records_conflicts<T, std::void_t<decltype(std::declval<T &>().record_conflict(bool{}))>> {
+            static constexpr bool value = true;
+        };
     }
 
     template<typename T>
@@ -362,6 +396,28 @@ namespace bimap::impl {
         T * data;
     };
 
+    struct BaseAccess;
+
+    /**
+     * Bijective 64 bit mixing function (finalizer of splitmix64)
+     */
+    constexpr std::uint64_t mix_bits(std::uint64_t x) noexcept {
+        x = (x ^ (x >> 30u)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27u)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31u);
+    }
+
+    /**
+     * Fingerprint of a single key pair. Fingerprints of all pairs are summed up which makes the fingerprint of the
+     * container independent of element order
+     * @param forwardHash hash of the forward key
+     * @param inverseHash hash of the inverse key
+     * @return mixed hash that depends on the order of its arguments
+     */
+    constexpr std::uint64_t item_fingerprint(std::uint64_t forwardHash, std::uint64_t inverseHash) noexcept {
+        return mix_bits(forwardHash + mix_bits(inverseHash ^ 0x9e3779b97f4a7c15ull));
+    }
+
     // stolen from here https://quuxplusone.github.io/blog/2019/02/06/arrow-proxy/
     template<typename T>
     struct arrow_proxy {
@@ -374,12 +430,296 @@ namespace bimap::impl {
             return &t;
         }
     };
+
+    /**
+     * @brief Inverse lookup of a container that stores both keys of a pair in a single table entry. Valid as long as
+     * the container exists
+     * @details The container grants friendship to this class and provides the private member functions inverseFind,
+     * inverseContains, inverseAt and inverseErase, which take an inverse key. begin() and end() are only available if
+     * the container also provides inverseBegin and inverseEnd
+     * @tparam Map container type
+     * @tparam Key inverse key type
+     * @tparam Mapped forward key type
+     * @tparam Const whether the view only grants read access to the container
+     */
+    template<typename Map, typename Key, typename Mapped, bool Const>
+    class inverse_view {
+        using MapType = std::conditional_t<Const, const Map, Map>;
+    public:
+        explicit inverse_view(MapType &map) noexcept: map(&map) {}
+
+        /**
+         * Conversion from mutable to const view
+         * @param other source
+         */
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        inverse_view(const inverse_view<Map, Key, Mapped, false> &other) noexcept: map(&other.inverse()) {}
+
+        template<typename M = Map>
+        auto begin() const noexcept -> decltype(std::declval<const M &>().inverseBegin()) {
+            return map->inverseBegin();
+        }
+
+        template<typename M = Map>
+        auto end() const noexcept -> decltype(std::declval<const M &>().inverseEnd()) {
+            return map->inverseEnd();
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept {
+            return map->size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return map->empty();
+        }
+
+        /**
+         * Finds the pair with the given inverse key
+         * @param key key used for lookup
+         * @return position of the found pair in the same representation the forward find uses
+         */
+        auto find(const Key &key) const noexcept(noexcept(std::declval<const Map &>().inverseFind(key))) {
+            return map->inverseFind(key);
+        }
+
+        /**
+         * Check if a certain inverse key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        bool contains(const Key &key) const noexcept(noexcept(std::declval<const Map &>().inverseContains(key))) {
+            return map->inverseContains(key);
+        }
+
+        /**
+         * Returns the forward key found by the given inverse key
+         * @param key key used for lookup
+         * @return reference to found forward key
+         * @throws std::out_of_range if key does not exist
+         */
+        const Mapped &at(const Key &key) const {
+            return map->inverseAt(key);
+        }
+
+        /**
+         * Erases the pair with the given inverse key
+         * @param key key of the pair to erase
+         * @return number of erased pairs (0 or 1)
+         */
+        template<bool C = Const, typename = std::enable_if_t<!C>>
+        std::size_t erase(const Key &key) noexcept(noexcept(std::declval<Map &>().inverseErase(key))) {
+            return map->inverseErase(key);
+        }
+
+        /**
+         * Access to forward lookup
+         */
+        MapType &inverse() const noexcept {
+            return *map;
+        }
+
+    private:
+        MapType *map;
+    };
 }
 
 /**
  * @brief namespace containing the bidirectional map class
  */
 namespace bimap {
+    /**
+     * @brief Customization point for memory that keys own outside of the container nodes.
+     * @details Specialize this struct for key types that own heap memory. Specializations must provide a static
+     * constexpr bool member `enabled` and a call operator that returns the number of heap bytes owned by a key. Keys
+     * are immutable inside a bidirectional_map, so the result must not change while a key is contained. Example for a
+     * type called `MyString`
+     * ```
+     * template<>
+     * struct bimap::heap_size<MyString> {
+     *     static constexpr bool enabled = true;
+     *     std::size_t operator()(const MyString &str) const noexcept { return str.capacity(); }
+     * };
+     * ```
+     * @tparam T key type
+     */
+    template<typename T>
+    struct heap_size {
+        static constexpr bool enabled = false;
+
+        constexpr std::size_t operator()(const T &) const noexcept {
+            return 0;
+        }
+    };
+
+    template<typename Char, typename Traits, typename Alloc>
+    struct heap_size<std::basic_string<Char, Traits, Alloc>> {
+        static constexpr bool enabled = true;
+
+        std::size_t operator()(const std::basic_string<Char, Traits, Alloc> &str) const noexcept {
+            // short strings are stored inside the string object
+            const auto data = reinterpret_cast<std::uintptr_t>(str.data());
+            const auto object = reinterpret_cast<std::uintptr_t>(&str);
+            if (data >= object && data < object + sizeof(str)) {
+                return 0;
+            }
+
+            return (str.capacity() + 1) * sizeof(Char);
+        }
+    };
+
+    template<typename T, typename Alloc>
+    struct heap_size<std::vector<T, Alloc>> {
+        static constexpr bool enabled = true;
+
+        std::size_t operator()(const std::vector<T, Alloc> &vec) const noexcept {
+            return vec.capacity() * sizeof(T);
+        }
+    };
+
+    /**
+     * @brief Customization point for the memory used by a base container.
+     * @details Specialize this struct for custom base containers. The default assumes one allocation of
+     * sizeof(value_type) per element and no bucket array. The specializations for standard containers estimate the
+     * node layout of common standard library implementations including allocator bookkeeping. All functions must be
+     * cheap (ideally O(1)) since memory usage is meant to be queried frequently
+     * @tparam Map base container type
+     */
+    template<typename Map>
+    struct container_footprint {
+        static std::size_t nodes(const Map &map) noexcept {
+            return map.size() * sizeof(typename Map::value_type);
+        }
+
+        static std::size_t buckets(const Map &) noexcept {
+            return 0;
+        }
+    };
+
+    namespace impl {
+        /**
+         * Approximate size of a heap allocation of the given size including allocator bookkeeping
+         * @param bytes requested number of bytes
+         * @return size of the allocated chunk
+         */
+        constexpr std::size_t allocation_size(std::size_t bytes) noexcept {
+            constexpr std::size_t Granularity = 2 * sizeof(void *);
+            return (bytes + sizeof(void *) + Granularity - 1) / Granularity * Granularity;
+        }
+
+        template<typename Map, std::size_t NodeOverhead>
+        struct node_footprint {
+            static std::size_t nodes(const Map &map) noexcept {
+                return map.size() * allocation_size(NodeOverhead + sizeof(typename Map::value_type));
+            }
+        };
+
+        // next pointer and cached hash
+        template<typename Map>
+        struct hash_footprint : node_footprint<Map, sizeof(void *) + sizeof(std::size_t)> {
+            static std::size_t buckets(const Map &map) noexcept {
+                return map.bucket_count() * sizeof(void *);
+            }
+        };
+
+        // parent, left and right pointer and color
+        template<typename Map>
+        struct tree_footprint : node_footprint<Map, 4 * sizeof(void *)> {
+            static std::size_t buckets(const Map &) noexcept {
+                return 0;
+            }
+        };
+    }
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+    struct container_footprint<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>>
+            : impl::hash_footprint<std::unordered_map<Key, T, Hash, KeyEqual, Alloc>> {};
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+    struct container_footprint<std::unordered_multimap<Key, T, Hash, KeyEqual, Alloc>>
+            : impl::hash_footprint<std::unordered_multimap<Key, T, Hash, KeyEqual, Alloc>> {};
+
+    template<typename Key, typename T, typename Compare, typename Alloc>
+    struct container_footprint<std::map<Key, T, Compare, Alloc>>
+            : impl::tree_footprint<std::map<Key, T, Compare, Alloc>> {};
+
+    template<typename Key, typename T, typename Compare, typename Alloc>
+    struct container_footprint<std::multimap<Key, T, Compare, Alloc>>
+            : impl::tree_footprint<std::multimap<Key, T, Compare, Alloc>> {};
+
+    /**
+     * @brief Memory used by a bidirectional_map in bytes, see bidirectional_map::memory_usage
+     */
+    struct memory_footprint {
+        /// Nodes of the forward base container
+        std::size_t forward_nodes = 0;
+        /// Nodes of the inverse base container
+        std::size_t inverse_nodes = 0;
+        /// Bucket array of the forward base container
+        std::size_t forward_buckets = 0;
+        /// Bucket array of the inverse base container
+        std::size_t inverse_buckets = 0;
+        /// Heap memory owned by forward keys, see heap_size
+        std::size_t forward_key_storage = 0;
+        /// Heap memory owned by inverse keys, see heap_size
+        std::size_t inverse_key_storage = 0;
+        /// Separately allocated inverse map object
+        std::size_t inverse_object = 0;
+
+        /**
+         * Sum of all parts
+         */
+        [[nodiscard]] constexpr std::size_t total() const noexcept {
+            return forward_nodes + inverse_nodes + forward_buckets + inverse_buckets + forward_key_storage +
+                   inverse_key_storage + inverse_object;
+        }
+    };
+
+    /**
+     * @brief Operations whose latency can be recorded by a latency policy
+     */
+    enum class map_operation {
+        emplace, erase, find
+    };
+
+    /**
+     * @brief Default latency policy of bidirectional_map which does not record anything.
+     * @details A latency policy must provide a static constexpr bool member `enabled`. If it is true, the policy
+     * must also provide the static noexcept functions `std::uint64_t now()`, which returns a timestamp, and
+     * `void record(map_operation op, bool inverse, std::uint64_t ticks)`. bidirectional_map calls record after each
+     * emplace, erase and find. The inverse flag is set for operations called through inverse(). See
+     * latency_histogram.hpp for a policy that records histograms
+     */
+    struct no_latency_policy {
+        static constexpr bool enabled = false;
+    };
+
+    namespace impl {
+        /**
+         * @brief Measures the time until the end of the scope and reports it to the latency policy. Empty if the
+         * policy is disabled
+         */
+        template<typename Policy, bool Enabled = Policy::enabled>
+        struct latency_scope {
+            constexpr latency_scope(map_operation, bool) noexcept {}
+        };
+
+        template<typename Policy>
+        struct latency_scope<Policy, true> {
+            latency_scope(map_operation op, bool inverse) noexcept: op(op), inverse(inverse), start(Policy::now()) {}
+
+            latency_scope(const latency_scope &) = delete;
+            latency_scope &operator=(const latency_scope &) = delete;
+
+            ~latency_scope() {
+                Policy::record(op, inverse, Policy::now() - start);
+            }
+
+            map_operation op;
+            bool inverse;
+            std::uint64_t start;
+        };
+    }
+
     /**
      * @brief Bidirectional associative container that supports efficient lookup in both directions.
      * @details This class manages two unidirectional maps in order to enable bidirectional lookup. Neither items of
@@ -393,6 +733,8 @@ namespace bimap {
      * @tparam InverseKey Type of key used for inverse lookup
      * @tparam ForwardMapType base map container used for forward lookup. Default is std::unordered_map
      * @tparam InverseMapType base map container used for inverse lookup. Default is std::unordered_map
+     * @tparam LatencyPolicy records the latency of emplace, erase and find, see no_latency_policy. The default does
+     * not record anything
      * @note when specifying the underlying map types, make sure that the respective types expect two template type
      * arguments. Further arguments have to be deducible or have defaults. Using a custom map type not included in the
      * list should be possible. Make sure that the typical map member functions (like find, emplace, etc) are supported
@@ -401,26 +743,76 @@ namespace bimap {
      */
     template<typename ForwardKey, typename InverseKey,
              template<typename ...> typename ForwardMapType = std::unordered_map,
-             template<typename ...> typename InverseMapType = std::unordered_map>
+             template<typename ...> typename InverseMapType = std::unordered_map,
+             typename LatencyPolicy = no_latency_policy>
     class bidirectional_map {
     private:
         using ForwardMap = ForwardMapType<ForwardKey, impl::Surrogate<const InverseKey>>;
-        using InverseBiMap = bidirectional_map<InverseKey, ForwardKey, InverseMapType, ForwardMapType>;
+        using InverseBiMap = bidirectional_map<InverseKey, ForwardKey, InverseMapType, ForwardMapType, LatencyPolicy>;
+        using LatencyScope = impl::latency_scope<LatencyPolicy>;
         friend InverseBiMap;
         using InverseMap = typename InverseBiMap::ForwardMap;
         using InversBiMapPtr = impl::AllocOncePointer<InverseBiMap>;
 
         friend class impl::AllocOncePointer<bidirectional_map>;
+        friend struct impl::BaseAccess;
 
         static_assert(std::is_default_constructible<ForwardMap>::value,
                       "ForwardMap base containers must be default constructable.");
         static_assert(std::is_copy_constructible<ForwardMap>::value,
                       "ForwardMap base containers must be copy constructable.");
 
+        static constexpr bool HasFingerprint = impl::traits::is_hashable<ForwardKey>::value &&
+                                               impl::traits::is_hashable<InverseKey>::value;
+        static constexpr bool HasKeyStorage = heap_size<ForwardKey>::enabled || heap_size<InverseKey>::enabled;
+
         explicit bidirectional_map(
                 InverseBiMap &inverseMap) noexcept(std::is_nothrow_default_constructible_v<ForwardMap>)
                 : map(), inverseAccess(&inverseMap) {}
 
+        void updateFingerprint(const ForwardKey &forwardKey, const InverseKey &inverseKey, bool insertion) {
+            if constexpr (HasFingerprint) {
+                const std::uint64_t forwardHash = std::hash<ForwardKey>{}(forwardKey);
+                const std::uint64_t inverseHash = std::hash<InverseKey>{}(inverseKey);
+                const auto forwardItem = impl::item_fingerprint(forwardHash, inverseHash);
+                const auto inverseItem = impl::item_fingerprint(inverseHash, forwardHash);
+                if (insertion) {
+                    contentFingerprint += forwardItem;
+                    inverseAccess->contentFingerprint += inverseItem;
+                } else {
+                    contentFingerprint -= forwardItem;
+                    inverseAccess->contentFingerprint -= inverseItem;
+                }
+            }
+        }
+
+        void updateKeyStorage(const ForwardKey &forwardKey, const InverseKey &inverseKey, bool insertion) noexcept {
+            if constexpr (HasKeyStorage) {
+                const auto forwardBytes = heap_size<ForwardKey>{}(forwardKey);
+                const auto inverseBytes = heap_size<InverseKey>{}(inverseKey);
+                if (insertion) {
+                    keyStorage += forwardBytes;
+                    inverseAccess->keyStorage += inverseBytes;
+                } else {
+                    keyStorage -= forwardBytes;
+                    inverseAccess->keyStorage -= inverseBytes;
+                }
+            }
+        }
+
+        /**
+         * Whether this object is the inverse of a user created map
+         */
+        constexpr bool isInverse() const noexcept {
+            return !inverseAccess.isOwner();
+        }
+
+        void recordConflict(bool inverseKey) noexcept {
+            if constexpr (impl::traits::records_conflicts<ForwardMap>::value) {
+                map.record_conflict(inverseKey);
+            }
+        }
+
     public:
         /**
          * @brief bidirectional_map iterator
@@ -437,7 +829,7 @@ namespace bimap {
             using value_type = std::pair<const ForwardKey &, const InverseKey &>;
             using reference = value_type;
             using pointer = impl::arrow_proxy<value_type>;
-            using diference_type = typename std::iterator_traits<IteratorType>::difference_type;
+            using difference_type = typename std::iterator_traits<IteratorType>::difference_type;
             using iterator_category = typename std::iterator_traits<IteratorType>::iterator_category;
 
             /**
@@ -622,6 +1014,10 @@ namespace bimap {
                                                      std::is_nothrow_swappable_v<InverseMap>) {
             std::swap(this->map, other.map);
             std::swap(this->inverseAccess->map, other.inverseAccess->map);
+            std::swap(this->contentFingerprint, other.contentFingerprint);
+            std::swap(this->inverseAccess->contentFingerprint, other.inverseAccess->contentFingerprint);
+            std::swap(this->keyStorage, other.keyStorage);
+            std::swap(this->inverseAccess->keyStorage, other.inverseAccess->keyStorage);
         }
 
         /**
@@ -659,24 +1055,30 @@ namespace bimap {
          */
         template<typename ...ARGS>
         auto emplace(ARGS &&...args) -> std::pair<iterator, bool> {
+            LatencyScope scope(map_operation::emplace, isInverse());
             std::pair<ForwardKey, InverseKey> tmp(std::forward<ARGS>(args)...);
+            // base containers are used directly so that lookups are not timed separately
             if constexpr(!impl::traits::is_multimap_v<ForwardMap>) {
-                auto res = find(tmp.first);
-                if (res != end()) {
-                    return {res, false};
+                auto res = map.find(tmp.first);
+                if (res != map.end()) {
+                    recordConflict(false);
+                    return {iterator(res), false};
                 }
             }
 
             if constexpr(!impl::traits::is_multimap_v<InverseMap>) {
-                auto invRes = inverse().find(tmp.second);
-                if (invRes != inverse().end()) {
-                    return {find(invRes->second), false};
+                auto invRes = inverseAccess->map.find(tmp.second);
+                if (invRes != inverseAccess->map.end()) {
+                    recordConflict(true);
+                    return {iterator(map.find(*invRes->second)), false};
                 }
             }
 
             auto it = impl::get_first(map.emplace(std::move(tmp.first), nullptr));
             auto invIt = impl::get_first(inverseAccess->map.emplace(std::move(tmp.second), &it->first));
             it->second = &invIt->first;
+            updateFingerprint(it->first, invIt->first, true);
+            updateKeyStorage(it->first, invIt->first, true);
             return {iterator(it), true};
         }
 
@@ -739,6 +1141,7 @@ namespace bimap {
          */
         iterator find(const ForwardKey &key) const noexcept(noexcept(std::declval<ForwardMap>().find(key)) &&
                                                             iterator_ctor_nothrow) {
+            LatencyScope scope(map_operation::find, isInverse());
             return iterator(map.find(key));
         }
 
@@ -780,29 +1183,170 @@ namespace bimap {
         }
 
         /**
-         * Erases the element at position pos
-         * @param pos iterator to the element to remove. if pos == end(), this method does nothing
-         * @return iterator pointing to the next element in the container
+         * Calls prefix_range on the underlying container. Only available when using containers that support prefix
+         * search like bimap::radix_trie_map
+         * @param prefix key prefix
+         * @return iterator range containing all elements whose forward key starts with prefix
          */
-        iterator erase(iterator pos) {
-            if (pos == end()) {
-                return pos;
-            }
+        template<REQUIRES_THAT(ForwardMap, std::declval<_T_>().prefix_range(std::declval<ForwardKey>()))>
+        auto prefix_range(const ForwardKey &prefix) const
+                noexcept(noexcept(std::declval<ForwardMap>().prefix_range(prefix)) && iterator_ctor_nothrow)
+                -> std::pair<iterator, iterator> {
+            auto [first, last] = map.prefix_range(prefix);
+            return {iterator(first), iterator(last)};
+        }
 
-            if constexpr(impl::traits::is_multimap_v<InverseMap>) {
-                auto [curr, end] = inverse().equal_range(pos->second);
-                while (curr != end && &curr->first != pos.it->second.get()) {
-                    ++curr;
+        /**
+         * Calls fn for every element with forward key in [lo, hi) using multiple threads. Only available when using
+         * containers that support parallel range scans like bimap::partitioned_map
+         * @tparam Fn function type
+         * @param lo lower bound of forward keys (inclusive)
+         * @param hi upper bound of forward keys (exclusive)
+         * @param fn function that is called with (const ForwardKey &, const InverseKey &). Must be safe to be called
+         * concurrently
+         */
+        template<typename Fn, REQUIRES_THAT(ForwardMap, std::declval<_T_>().parallel_range_for_each(
+                std::declval<ForwardKey>(), std::declval<ForwardKey>(),
+                std::declval<void (*)(const typename _T_::value_type &)>()))>
+        void parallel_range_for_each(const ForwardKey &lo, const ForwardKey &hi, Fn &&fn) const {
+            map.parallel_range_for_each(lo, hi, [&fn](const auto &item) { fn(item.first, *item.second); });
+        }
+
+        /**
+         * Calls fn for every element using multiple threads. Only available when using containers that support
+         * parallel scans like bimap::partitioned_map
+         * @tparam Fn function type
+         * @param fn function that is called with (const ForwardKey &, const InverseKey &). Must be safe to be called
+         * concurrently
+         */
+        template<typename Fn, REQUIRES_THAT(ForwardMap, std::declval<_T_>().parallel_for_each(
+                std::declval<void (*)(const typename _T_::value_type &)>()))>
+        void parallel_for_each(Fn &&fn) const {
+            map.parallel_for_each([&fn](const auto &item) { fn(item.first, *item.second); });
+        }
+
+        /**
+         * Calls rank on the underlying container. Only available when using containers that support order statistics
+         * like bimap::order_statistics_map
+         * @param key Key used for lookup
+         * @return number of elements with forward key less than key
+         */
+        template<REQUIRES_THAT(ForwardMap, std::declval<_T_>().rank(std::declval<ForwardKey>()))>
+        auto rank(const ForwardKey &key) const noexcept(noexcept(std::declval<ForwardMap>().rank(key))) {
+            return map.rank(key);
+        }
+
+        /**
+         * Calls select on the underlying container. Only available when using containers that support order
+         * statistics like bimap::order_statistics_map
+         * @param k zero based index in forward key order
+         * @return iterator to the k-th smallest element. If k >= size(), past-the-end iterator is returned
+         */
+        template<REQUIRES_THAT(ForwardMap, std::declval<_T_>().select(std::size_t{}))>
+        auto select(std::size_t k) const noexcept(noexcept(std::declval<ForwardMap>().select(k)) &&
+                                                  iterator_ctor_nothrow) -> iterator {
+            return iterator(map.select(k));
+        }
+
+        /**
+         * Calls count_range on the underlying container. Only available when using containers that support order
+         * statistics like bimap::order_statistics_map
+         * @param lo lower bound of forward keys (inclusive)
+         * @param hi upper bound of forward keys (exclusive)
+         * @return number of elements with forward key in [lo, hi)
+         */
+        template<REQUIRES_THAT(ForwardMap, std::declval<_T_>().count_range(std::declval<ForwardKey>(),
+                                                                           std::declval<ForwardKey>()))>
+        auto count_range(const ForwardKey &lo, const ForwardKey &hi) const
+                noexcept(noexcept(std::declval<ForwardMap>().count_range(lo, hi))) {
+            return map.count_range(lo, hi);
+        }
+
+        /**
+         * Orthogonal range query over (forward key, inverse key) pairs. Calls fn for every pair with forward key in
+         * [lo1, hi1] and inverse key in [lo2, hi2]. Only available when using containers that maintain a two
+         * dimensional index like bimap::range_indexed_map
+         * @tparam Fn function type
+         * @param lo1 lower bound of forward keys (inclusive)
+         * @param hi1 upper bound of forward keys (inclusive)
+         * @param lo2 lower bound of inverse keys (inclusive)
+         * @param hi2 upper bound of inverse keys (inclusive)
+         * @param fn function that is called with (const ForwardKey &, const InverseKey &). Pairs are reported in no
+         * particular order
+         */
+        template<typename Fn, REQUIRES_THAT(ForwardMap, std::declval<_T_>().range_count(
+                std::declval<ForwardKey>(), std::declval<ForwardKey>(), std::declval<InverseKey>(),
+                std::declval<InverseKey>()))>
+        void range_query(const ForwardKey &lo1, const ForwardKey &hi1, const InverseKey &lo2, const InverseKey &hi2,
+                         Fn &&fn) const {
+            map.range_query(lo1, hi1, lo2, hi2, [&fn](const auto &item) { fn(item.first, *item.second); });
+        }
+
+        /**
+         * Number of pairs with forward key in [lo1, hi1] and inverse key in [lo2, hi2]. Only available when using
+         * containers that maintain a two dimensional index like bimap::range_indexed_map
+         * @param lo1 lower bound of forward keys (inclusive)
+         * @param hi1 upper bound of forward keys (inclusive)
+         * @param lo2 lower bound of inverse keys (inclusive)
+         * @param hi2 upper bound of inverse keys (inclusive)
+         * @return number of pairs in the query rectangle
+         */
+        template<REQUIRES_THAT(ForwardMap, std::declval<_T_>().range_count(
+                std::declval<ForwardKey>(), std::declval<ForwardKey>(), std::declval<InverseKey>(),
+                std::declval<InverseKey>()))>
+        auto range_count(const ForwardKey &lo1, const ForwardKey &hi1, const InverseKey &lo2,
+                         const InverseKey &hi2) const {
+            return map.range_count(lo1, hi1, lo2, hi2);
+        }
+
+        /**
+         * Reserves space for at least count elements in both base containers. Only available if both base containers
+         * support reserve
+         * @param count number of elements
+         */
+        template<typename _T_ = ForwardMap, typename _U_ = InverseMap,
+                 typename = std::void_t<decltype(std::declval<_T_ &>().reserve(std::size_t{})),
+                                        decltype(std::declval<_U_ &>().reserve(std::size_t{}))>>
+        void reserve(std::size_t count) {
+            map.reserve(count);
+            inverseAccess->map.reserve(count);
+        }
+
+        /**
+         * Applies a set of changes to the map. First, all erasures are carried out, then all insertions. Erasures of
+         * items that are not contained in the map are ignored.
+         * @tparam Changeset type with members erasures and insertions, both ranges of pairs (forward key, inverse key),
+         * for example bimap::changeset (see algorithms.hpp)
+         * @param changes set of changes, for example obtained by bimap::diff
+         */
+        template<typename Changeset>
+        void apply(const Changeset &changes) {
+            for (const auto &[key, value] : changes.erasures) {
+                for (auto [curr, last] = equal_range(key); curr != last; ++curr) {
+                    if (curr->second == value) {
+                        erase(curr);
+                        break;
+                    }
                 }
+            }
 
-                assert(curr != end);
-                inverseAccess->map.erase(curr.it);
+            if constexpr (impl::traits::has_reserve<bidirectional_map>::value) {
+                reserve(size() + changes.insertions.size());
+            }
 
-            } else {
-                inverseAccess->map.erase(inverseAccess->map.find(pos->second));
+            for (const auto &[key, value] : changes.insertions) {
+                emplace(key, value);
             }
+        }
 
-            return iterator(map.erase(pos.it));
+        /**
+         * Erases the element at position pos
+         * @param pos iterator to the element to remove. if pos == end(), this method does nothing
+         * @return iterator pointing to the next element in the container
+         */
+        iterator erase(iterator pos) {
+            LatencyScope scope(map_operation::erase, isInverse());
+            return eraseAt(pos);
         }
 
         /**
@@ -811,11 +1355,11 @@ namespace bimap {
          * @return number of erased elements
          */
         std::size_t erase(const ForwardKey &key) {
-            auto [curr, last] = equal_range(key);
+            LatencyScope scope(map_operation::erase, isInverse());
+            auto [first, last] = map.equal_range(key);
             std::size_t numErased = 0;
-            while (curr != last) {
-                curr = erase(curr);
-                ++numErased;
+            for (iterator curr(first); curr != iterator(last); ++numErased) {
+                curr = eraseAt(curr);
             }
 
             return numErased;
@@ -828,15 +1372,17 @@ namespace bimap {
          * @return iterator following the last removed element
          */
         iterator erase(iterator first, iterator last) {
+            LatencyScope scope(map_operation::erase, isInverse());
             while (first != last && first != end()) {
-                first = erase(first);
+                first = eraseAt(first);
             }
 
             return first;
         }
 
         /**
-         * Compares underlying containers
+         * Compares underlying containers. If both key types are hashable, maps with different fingerprints are
+         * rejected in O(1). Unless the inverse container is a multimap, only the forward containers are compared
          * @param other right hand side
          * @return true if both forward mapping and inverse mapping are equivalent
          * @note for more details see documentation of the used underlying containers. If the default containers are
@@ -844,7 +1390,18 @@ namespace bimap {
          */
         bool operator==(const bidirectional_map &other) const noexcept(impl::traits::nothrow_comparable<ForwardMap> &&
                                                                        impl::traits::nothrow_comparable<InverseMap>) {
-            return map == other.map && inverseAccess->map == other.inverseAccess->map;
+            if constexpr (HasFingerprint) {
+                if (contentFingerprint != other.contentFingerprint) {
+                    return false;
+                }
+            }
+
+            // equal forward containers contain the same key pairs. Only inverse multimaps can differ in element order
+            if constexpr (impl::traits::is_multimap_v<InverseMap>) {
+                return map == other.map && inverseAccess->map == other.inverseAccess->map;
+            } else {
+                return map == other.map;
+            }
         }
 
         /**
@@ -863,6 +1420,10 @@ namespace bimap {
                               noexcept(std::declval<InverseMap>().clear())) {
             map.clear();
             inverseAccess->map.clear();
+            contentFingerprint = 0;
+            inverseAccess->contentFingerprint = 0;
+            keyStorage = 0;
+            inverseAccess->keyStorage = 0;
         }
 
         /**
@@ -893,10 +1454,103 @@ namespace bimap {
             return res->second;
         }
 
+        /**
+         * Order independent fingerprint of the contained key pairs. It is maintained incrementally on insertion and
+         * erasure. Equal maps have equal fingerprints, so maps with different fingerprints can be told apart in O(1).
+         * @return fingerprint of the contents
+         * @note only available if std::hash is specialized for both ForwardKey and InverseKey. std::hash must be
+         * consistent with operator== of the respective key type
+         */
+        template<bool Enabled = HasFingerprint>
+        [[nodiscard]] auto fingerprint() const noexcept -> std::enable_if_t<Enabled, std::size_t> {
+            return static_cast<std::size_t>(contentFingerprint);
+        }
+
+        /**
+         * Memory used by the map, split by lookup direction. Node and bucket sizes are estimated by
+         * container_footprint, heap memory owned by keys is tracked on insertion and erasure using heap_size. Runs in
+         * O(1) for the standard containers
+         * @return memory usage in bytes. For inverse(), forward and inverse parts are swapped
+         */
+        [[nodiscard]] memory_footprint memory_usage() const noexcept {
+            memory_footprint ret;
+            ret.forward_nodes = container_footprint<ForwardMap>::nodes(map);
+            ret.inverse_nodes = container_footprint<InverseMap>::nodes(inverseAccess->map);
+            ret.forward_buckets = container_footprint<ForwardMap>::buckets(map);
+            ret.inverse_buckets = container_footprint<InverseMap>::buckets(inverseAccess->map);
+            ret.forward_key_storage = keyStorage;
+            ret.inverse_key_storage = inverseAccess->keyStorage;
+            ret.inverse_object = inverseAccess.isOwner() ? sizeof(InverseBiMap) : sizeof(bidirectional_map);
+            return ret;
+        }
+
+        /**
+         * Statistics of the forward lookup direction, see instrumented_map::statistics. Only available when using
+         * containers that collect statistics like bimap::instrumented_map. Use inverse().statistics() for the inverse
+         * direction
+         * @return current statistics
+         */
+        template<REQUIRES_THAT(ForwardMap, std::declval<_T_>().statistics())>
+        auto statistics() const {
+            return map.statistics();
+        }
+
+        /**
+         * Resets the statistics of the forward lookup direction. Only available when using containers that collect
+         * statistics like bimap::instrumented_map
+         */
+        template<REQUIRES_THAT(ForwardMap, std::declval<_T_ &>().reset_statistics())>
+        void reset_statistics() {
+            map.reset_statistics();
+        }
+
     private:
+        /**
+         * Erases the element at pos without recording its latency
+         */
+        auto eraseAt(iterator pos) -> iterator {
+            if (pos == end()) {
+                return pos;
+            }
+
+            updateFingerprint(pos->first, pos->second, false);
+            updateKeyStorage(pos->first, pos->second, false);
+            if constexpr(impl::traits::is_multimap_v<InverseMap>) {
+                auto [curr, end] = inverseAccess->map.equal_range(pos->second);
+                while (curr != end && &curr->first != pos.it->second.get()) {
+                    ++curr;
+                }
+
+                assert(curr != end);
+                inverseAccess->map.erase(curr);
+
+            } else {
+                inverseAccess->map.erase(inverseAccess->map.find(pos->second));
+            }
+
+            return iterator(map.erase(pos.it));
+        }
+
         ForwardMap map;
         InversBiMapPtr inverseAccess;
+        std::uint64_t contentFingerprint = 0;
+        std::size_t keyStorage = 0;
     };
+}
+
+namespace bimap::impl {
+    /**
+     * @brief Gives free functions operating on bidirectional_maps read access to the forward base container
+     */
+    struct BaseAccess {
+        template<typename BiMap>
+        static constexpr auto &forward(BiMap &biMap) noexcept {
+            return biMap.map;
+        }
+    };
+}
+
+namespace bimap {
 
     /**
      * See member function bidirectional_map::swap
@@ -905,9 +1559,10 @@ namespace bimap {
      */
     template<typename ForwardKey, typename InverseKey,
             template<typename ...> typename ForwardMapType = std::unordered_map,
-            template<typename ...> typename InverseMapType = std::unordered_map>
-    void swap(bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType> &lhs,
-              bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType> &rhs)
+            template<typename ...> typename InverseMapType = std::unordered_map,
+            typename LatencyPolicy = no_latency_policy>
+    void swap(bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &lhs,
+              bidirectional_map<ForwardKey, InverseKey, ForwardMapType, InverseMapType, LatencyPolicy> &rhs)
     noexcept(noexcept(lhs.swap(rhs))) {
         lhs.swap(rhs);
     }
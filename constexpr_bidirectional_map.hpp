@@ -0,0 +1,281 @@
+/**
+ * @file constexpr_bidirectional_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a fixed size bidirectional map that can be constructed and queried in constant
+ * expressions. It is intended for static lookup tables like enum <-> string mappings.
+ */
+
+#ifndef BIDIRECTIONALMAP_CONSTEXPR_BIDIRECTIONAL_MAP_HPP
+#define BIDIRECTIONALMAP_CONSTEXPR_BIDIRECTIONAL_MAP_HPP
+
+#include <array>
+#include <utility>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace bimap {
+    namespace impl {
+        /**
+         * Computes the order of the given items by stable insertion sort in a constant expression
+         * @return indices of the items in sorted order
+         */
+        template<typename Item, std::size_t N, typename Proj, typename Compare>
+        constexpr auto sorted_order(const Item (&items)[N], Proj proj, Compare comp) -> std::array<std::size_t, N> {
+            std::array<std::size_t, N> order{};
+            for (std::size_t i = 0; i < N; ++i) {
+                std::size_t j = i;
+                for (; j > 0 && comp(proj(items[i]), proj(items[order[j - 1]])); --j) {
+                    order[j] = order[j - 1];
+                }
+
+                order[j] = i;
+            }
+
+            return order;
+        }
+
+        /**
+         * Copies the items in the given order, optionally swapping the components of each pair
+         */
+        template<bool Swap, typename First, typename Second, std::size_t N, std::size_t ...Is>
+        constexpr auto reorder(const std::pair<First, Second> (&items)[N], const std::array<std::size_t, N> &order,
+                               std::index_sequence<Is...>) {
+            if constexpr (Swap) {
+                return std::array<std::pair<Second, First>, N>{{
+                        std::pair<Second, First>(items[order[Is]].second, items[order[Is]].first)...}};
+            } else {
+                return std::array<std::pair<First, Second>, N>{{items[order[Is]]...}};
+            }
+        }
+    }
+
+    /**
+     * @brief Read only view of pairs sorted by key that supports lookup in both directions. Returned by
+     * constexpr_bidirectional_map::inverse
+     * @tparam Key key type
+     * @tparam Value value type
+     * @tparam Compare comparator used to order the keys
+     * @tparam ValueCompare comparator used to order the values
+     */
+    template<typename Key, typename Value, typename Compare, typename ValueCompare>
+    class constexpr_map_view {
+    public:
+        using iterator = const std::pair<Key, Value> *;
+
+        /**
+         * CTor
+         * @param items pairs sorted by key
+         * @param inverseItems the same pairs with swapped components sorted by value
+         * @param size number of pairs
+         */
+        constexpr constexpr_map_view(const std::pair<Key, Value> *items, const std::pair<Value, Key> *inverseItems,
+                                     std::size_t size) noexcept : items(items), inverseItems(inverseItems),
+                                                                  numItems(size) {}
+
+        constexpr iterator begin() const noexcept {
+            return items;
+        }
+
+        constexpr iterator end() const noexcept {
+            return items + numItems;
+        }
+
+        /**
+         * Number of pairs
+         */
+        [[nodiscard]] constexpr std::size_t size() const noexcept {
+            return numItems;
+        }
+
+        /**
+         * Whether the view is empty
+         */
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return numItems == 0;
+        }
+
+        /**
+         * Binary search for a key
+         * @param key key used for lookup
+         * @return pointer to the found pair or end() if key cannot be found
+         */
+        constexpr iterator find(const Key &key) const {
+            std::size_t first = 0;
+            std::size_t last = numItems;
+            while (first < last) {
+                const auto mid = first + (last - first) / 2;
+                if (Compare{}(items[mid].first, key)) {
+                    first = mid + 1;
+                } else {
+                    last = mid;
+                }
+            }
+
+            return first < numItems && !Compare{}(key, items[first].first) ? items + first : end();
+        }
+
+        /**
+         * Check if a certain key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        constexpr bool contains(const Key &key) const {
+            return find(key) != end();
+        }
+
+        /**
+         * Returns the value found by the given key
+         * @param key key used for lookup
+         * @return reference to found value
+         * @throws std::out_of_range if key does not exist. In constant expressions this results in a compile error
+         */
+        constexpr const Value &at(const Key &key) const {
+            auto res = find(key);
+            if (res == end()) {
+                throw std::out_of_range("constexpr bidirectional map key not found");
+            }
+
+            return res->second;
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return view of the pairs sorted by value
+         */
+        constexpr auto inverse() const noexcept -> constexpr_map_view<Value, Key, ValueCompare, Compare> {
+            return {inverseItems, items, numItems};
+        }
+
+    private:
+        const std::pair<Key, Value> *items;
+        const std::pair<Value, Key> *inverseItems;
+        std::size_t numItems;
+    };
+
+    /**
+     * @brief Fixed size bidirectional map that can be constructed and queried in constant expressions.
+     * @details The pairs are stored twice in sorted arrays, once ordered by forward key and once ordered by inverse
+     * key. Lookup uses binary search. No heap memory is used and no runtime initialization is necessary when the
+     * object is declared constexpr. Both key types must be literal types. Use make_constexpr_bidirectional_map to
+     * deduce the size:
+     * ```
+     * enum class Op {Add, Sub};
+     * constexpr auto ops = bimap::make_constexpr_bidirectional_map<Op, std::string_view>({{Op::Add, "add"},
+     *                                                                                   {Op::Sub, "sub"}});
+     * static_assert(ops.at(Op::Sub) == "sub");
+     * static_assert(ops.inverse().at("add") == Op::Add);
+     * ```
+     * @tparam ForwardKey type of forward keys
+     * @tparam InverseKey type of inverse keys
+     * @tparam N number of pairs
+     * @tparam ForwardCompare comparator used to order the forward keys
+     * @tparam InverseCompare comparator used to order the inverse keys
+     */
+    template<typename ForwardKey, typename InverseKey, std::size_t N,
+             typename ForwardCompare = std::less<ForwardKey>, typename InverseCompare = std::less<InverseKey>>
+    class constexpr_bidirectional_map {
+        using View = constexpr_map_view<ForwardKey, InverseKey, ForwardCompare, InverseCompare>;
+    public:
+        using iterator = typename View::iterator;
+        using value_type = std::pair<ForwardKey, InverseKey>;
+
+        /**
+         * Constructs the map from the given pairs
+         * @param items array of pairs
+         * @throws std::invalid_argument if a forward key or an inverse key occurs more than once. In constant
+         * expressions this results in a compile error
+         */
+        constexpr explicit constexpr_bidirectional_map(const value_type (&items)[N])
+                : forwardItems(impl::reorder<false>(
+                        items, impl::sorted_order(items, [](const value_type &item) -> const ForwardKey & {
+                            return item.first;
+                        }, ForwardCompare{}), std::make_index_sequence<N>{})),
+                  inverseItems(impl::reorder<true>(
+                          items, impl::sorted_order(items, [](const value_type &item) -> const InverseKey & {
+                              return item.second;
+                          }, InverseCompare{}), std::make_index_sequence<N>{})) {
+            for (std::size_t i = 1; i < N; ++i) {
+                if (!ForwardCompare{}(forwardItems[i - 1].first, forwardItems[i].first) ||
+                    !InverseCompare{}(inverseItems[i - 1].first, inverseItems[i].first)) {
+                    throw std::invalid_argument("duplicate key in constexpr bidirectional map");
+                }
+            }
+        }
+
+        constexpr iterator begin() const noexcept {
+            return view().begin();
+        }
+
+        constexpr iterator end() const noexcept {
+            return view().end();
+        }
+
+        /**
+         * @copydoc constexpr_map_view::size
+         */
+        [[nodiscard]] constexpr std::size_t size() const noexcept {
+            return N;
+        }
+
+        /**
+         * @copydoc constexpr_map_view::empty
+         */
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return N == 0;
+        }
+
+        /**
+         * @copydoc constexpr_map_view::find
+         */
+        constexpr iterator find(const ForwardKey &key) const {
+            return view().find(key);
+        }
+
+        /**
+         * @copydoc constexpr_map_view::contains
+         */
+        constexpr bool contains(const ForwardKey &key) const {
+            return view().contains(key);
+        }
+
+        /**
+         * @copydoc constexpr_map_view::at
+         */
+        constexpr const InverseKey &at(const ForwardKey &key) const {
+            return view().at(key);
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return view of the pairs sorted by inverse key. Valid as long as *this exists
+         */
+        constexpr auto inverse() const noexcept {
+            return view().inverse();
+        }
+
+    private:
+        constexpr View view() const noexcept {
+            return {forwardItems.data(), inverseItems.data(), N};
+        }
+
+        std::array<std::pair<ForwardKey, InverseKey>, N> forwardItems;
+        std::array<std::pair<InverseKey, ForwardKey>, N> inverseItems;
+    };
+
+    /**
+     * Creates a constexpr_bidirectional_map and deduces its size
+     * @tparam ForwardKey type of forward keys
+     * @tparam InverseKey type of inverse keys
+     * @tparam N number of pairs, deduced
+     * @param items pairs
+     * @return constexpr_bidirectional_map containing the pairs
+     */
+    template<typename ForwardKey, typename InverseKey, std::size_t N>
+    constexpr auto make_constexpr_bidirectional_map(const std::pair<ForwardKey, InverseKey> (&items)[N]) {
+        return constexpr_bidirectional_map<ForwardKey, InverseKey, N>(items);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_CONSTEXPR_BIDIRECTIONAL_MAP_HPP
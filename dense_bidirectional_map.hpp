@@ -0,0 +1,451 @@
+/**
+ * @file dense_bidirectional_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains an insertion ordered bidirectional map that stores its pairs in a contiguous vector.
+ */
+
+#ifndef BIDIRECTIONALMAP_DENSE_BIDIRECTIONAL_MAP_HPP
+#define BIDIRECTIONALMAP_DENSE_BIDIRECTIONAL_MAP_HPP
+
+#include <vector>
+#include <algorithm>
+#include <optional>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Bidirectional map that iterates in insertion order with a linear scan over a contiguous array.
+     * @details The pairs are stored in a vector of entries in insertion order. Forward and inverse lookup use two
+     * compact open addressing tables with linear probing that map keys to entry indices. Erasing removes the table
+     * entries with backward shift deletion and leaves a tombstone in the entry vector, so insertion order is
+     * preserved. When more than half of the entries are tombstones, the entry vector is compacted and the tables are
+     * rebuilt. Both operations invalidate iterators; insertion invalidates iterators like std::vector::push_back.
+     * ```
+     * bimap::dense_bidirectional_map<std::string, int> map;
+     * map.emplace("b", 1);
+     * map.emplace("a", 2);
+     * for (auto [name, id] : map) {...} // ("b", 1), ("a", 2)
+     * map.inverse().at(2); // "a"
+     * ```
+     * @tparam ForwardKey type of forward keys
+     * @tparam InverseKey type of inverse keys
+     * @tparam ForwardHash hash function for forward keys
+     * @tparam InverseHash hash function for inverse keys
+     * @tparam ForwardEqual equality comparator for forward keys
+     * @tparam InverseEqual equality comparator for inverse keys
+     */
+    template<typename ForwardKey, typename InverseKey,
+             typename ForwardHash = std::hash<ForwardKey>, typename InverseHash = std::hash<InverseKey>,
+             typename ForwardEqual = std::equal_to<ForwardKey>, typename InverseEqual = std::equal_to<InverseKey>>
+    class dense_bidirectional_map {
+        using Entry = std::optional<std::pair<ForwardKey, InverseKey>>;
+        using Index = std::uint32_t;
+        static constexpr Index Empty = std::numeric_limits<Index>::max();
+        using Table = std::vector<Index>;
+
+        template<bool Inverse>
+        class Iterator {
+            friend class dense_bidirectional_map;
+            using Key = std::conditional_t<Inverse, InverseKey, ForwardKey>;
+            using Value = std::conditional_t<Inverse, ForwardKey, InverseKey>;
+        public:
+            using value_type = std::pair<const Key &, const Value &>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            Iterator() = default;
+
+            Iterator(const Entry *pos, const Entry *last) noexcept: pos(pos), last(last) {
+                skip();
+            }
+
+            reference operator*() const noexcept {
+                if constexpr (Inverse) {
+                    return {(*pos)->second, (*pos)->first};
+                } else {
+                    return {(*pos)->first, (*pos)->second};
+                }
+            }
+
+            pointer operator->() const noexcept {
+                return {**this};
+            }
+
+            Iterator &operator++() noexcept {
+                ++pos;
+                skip();
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const Iterator &other) const noexcept {
+                return pos == other.pos;
+            }
+
+            bool operator!=(const Iterator &other) const noexcept {
+                return pos != other.pos;
+            }
+
+        private:
+            void skip() noexcept {
+                while (pos != last && !*pos) {
+                    ++pos;
+                }
+            }
+
+            const Entry *pos = nullptr;
+            const Entry *last = nullptr;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using inverse_iterator = Iterator<true>;
+        using inverse_view = impl::inverse_view<dense_bidirectional_map, InverseKey, ForwardKey, false>;
+        using const_inverse_view = impl::inverse_view<dense_bidirectional_map, InverseKey, ForwardKey, true>;
+
+        iterator begin() const noexcept {
+            return iteratorAt<false>(0);
+        }
+
+        iterator end() const noexcept {
+            return iteratorAt<false>(entries.size());
+        }
+
+        /**
+         * Number of contained pairs
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return numItems;
+        }
+
+        /**
+         * Whether the map is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return numItems == 0;
+        }
+
+        /**
+         * Constructs a pair in place at the end of the insertion order if neither key is already contained
+         * @tparam ARGS argument types
+         * @param args arguments used to construct the pair
+         * @return std::pair(iterator to inserted element or already existing element, bool whether insertion happened)
+         */
+        template<typename ...ARGS>
+        auto emplace(ARGS &&...args) -> std::pair<iterator, bool> {
+            std::pair<ForwardKey, InverseKey> tmp(std::forward<ARGS>(args)...);
+            if (auto res = find(tmp.first); res != end()) {
+                return {res, false};
+            }
+
+            if (auto index = indexOf<true>(tmp.second); index != Empty) {
+                return {iteratorAt<false>(index), false};
+            }
+
+            if (entries.size() >= Empty - 1) {
+                throw std::length_error("dense bidirectional map too large");
+            }
+
+            // entries grow geometrically, only the tables are resized here
+            reserveTables(numItems + 1);
+            const auto index = static_cast<Index>(entries.size());
+            entries.emplace_back(std::move(tmp));
+            forwardTable[findSlot<false>(entries.back()->first)] = index;
+            inverseTable[findSlot<true>(entries.back()->second)] = index;
+            ++numItems;
+            return {iteratorAt<false>(index), true};
+        }
+
+        /**
+         * Finds the pair with the given forward key
+         * @param key key used for lookup
+         * @return iterator to the found pair or end() if key cannot be found
+         */
+        iterator find(const ForwardKey &key) const {
+            auto index = indexOf<false>(key);
+            return iteratorAt<false>(index == Empty ? entries.size() : index);
+        }
+
+        /**
+         * Check if a certain key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        bool contains(const ForwardKey &key) const {
+            return find(key) != end();
+        }
+
+        /**
+         * Returns the value found by the given key
+         * @param key key used for lookup
+         * @return reference to found value
+         * @throws std::out_of_range if key does not exist
+         */
+        const InverseKey &at(const ForwardKey &key) const {
+            auto res = find(key);
+            if (res == end()) {
+                throw std::out_of_range("dense bidirectional map key not found");
+            }
+
+            return res->second;
+        }
+
+        /**
+         * Erases the pair with the given key. Preserves the insertion order of the remaining pairs
+         * @param key key of the pair to erase
+         * @return number of erased pairs (0 or 1)
+         */
+        std::size_t erase(const ForwardKey &key) {
+            auto index = indexOf<false>(key);
+            if (index == Empty) {
+                return 0;
+            }
+
+            eraseIndex(index);
+            return 1;
+        }
+
+        /**
+         * Erases all pairs
+         */
+        void clear() noexcept {
+            entries.clear();
+            std::fill(forwardTable.begin(), forwardTable.end(), Empty);
+            std::fill(inverseTable.begin(), inverseTable.end(), Empty);
+            numItems = 0;
+        }
+
+        /**
+         * Reserves space for the given number of pairs in the entry vector and both lookup tables
+         * @param count number of pairs
+         */
+        void reserve(std::size_t count) {
+            entries.reserve(count + (entries.size() - numItems));
+            reserveTables(count);
+        }
+
+        /**
+         * Removes all tombstones from the entry vector. Invalidates iterators
+         */
+        void compact() {
+            if (entries.size() == numItems) {
+                return;
+            }
+
+            // entries before the first tombstone stay in place, moving them onto themselves would empty them
+            auto tombstone = std::find_if(entries.begin(), entries.end(), [](const Entry &entry) { return !entry; });
+            auto target = static_cast<std::size_t>(tombstone - entries.begin());
+            for (auto index = target + 1; index < entries.size(); ++index) {
+                if (entries[index]) {
+                    entries[target++] = std::move(entries[index]);
+                }
+            }
+
+            entries.resize(target);
+            std::fill(forwardTable.begin(), forwardTable.end(), Empty);
+            std::fill(inverseTable.begin(), inverseTable.end(), Empty);
+            reindex();
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return view for lookup from inverse keys to forward keys
+         */
+        inverse_view inverse() noexcept {
+            return inverse_view(*this);
+        }
+
+        /**
+         * Read only access to inverse lookup
+         * @return view for lookup from inverse keys to forward keys
+         */
+        const_inverse_view inverse() const noexcept {
+            return const_inverse_view(*this);
+        }
+
+    private:
+        template<typename, typename, typename, bool>
+        friend class impl::inverse_view;
+
+        inverse_iterator inverseBegin() const noexcept {
+            return iteratorAt<true>(0);
+        }
+
+        inverse_iterator inverseEnd() const noexcept {
+            return iteratorAt<true>(entries.size());
+        }
+
+        inverse_iterator inverseFind(const InverseKey &key) const {
+            auto index = indexOf<true>(key);
+            return iteratorAt<true>(index == Empty ? entries.size() : index);
+        }
+
+        bool inverseContains(const InverseKey &key) const {
+            return inverseFind(key) != inverseEnd();
+        }
+
+        const ForwardKey &inverseAt(const InverseKey &key) const {
+            auto res = inverseFind(key);
+            if (res == inverseEnd()) {
+                throw std::out_of_range("dense bidirectional map key not found");
+            }
+
+            return res->second;
+        }
+
+        std::size_t inverseErase(const InverseKey &key) {
+            auto index = indexOf<true>(key);
+            if (index == Empty) {
+                return 0;
+            }
+
+            eraseIndex(index);
+            return 1;
+        }
+
+        /**
+         * Grows both lookup tables such that count pairs fit below the maximum load factor
+         */
+        void reserveTables(std::size_t count) {
+            if (2 * count > forwardTable.size()) {
+                std::size_t capacity = 16;
+                while (capacity < 2 * count) {
+                    capacity *= 2;
+                }
+
+                forwardTable.assign(capacity, Empty);
+                inverseTable.assign(capacity, Empty);
+                reindex();
+            }
+        }
+
+        template<bool Inverse>
+        Iterator<Inverse> iteratorAt(std::size_t index) const noexcept {
+            return {entries.data() + index, entries.data() + entries.size()};
+        }
+
+        template<bool Inverse>
+        Table &table() noexcept {
+            if constexpr (Inverse) {
+                return inverseTable;
+            } else {
+                return forwardTable;
+            }
+        }
+
+        template<bool Inverse>
+        const Table &table() const noexcept {
+            return const_cast<dense_bidirectional_map *>(this)->template table<Inverse>();
+        }
+
+        template<bool Inverse>
+        static const auto &keyOf(const Entry &entry) noexcept {
+            if constexpr (Inverse) {
+                return entry->second;
+            } else {
+                return entry->first;
+            }
+        }
+
+        template<bool Inverse>
+        std::size_t home(const std::conditional_t<Inverse, InverseKey, ForwardKey> &key) const {
+            using Hash = std::conditional_t<Inverse, InverseHash, ForwardHash>;
+            return static_cast<std::size_t>(impl::mix_bits(static_cast<std::uint64_t>(Hash{}(key)))) &
+                   (table<Inverse>().size() - 1);
+        }
+
+        /**
+         * Slot containing the key or the empty slot where it would be inserted. The table must not be empty
+         */
+        template<bool Inverse>
+        std::size_t findSlot(const std::conditional_t<Inverse, InverseKey, ForwardKey> &key) const {
+            using Equal = std::conditional_t<Inverse, InverseEqual, ForwardEqual>;
+            const auto &tab = table<Inverse>();
+            const auto mask = tab.size() - 1;
+            auto slot = home<Inverse>(key);
+            while (tab[slot] != Empty && !Equal{}(keyOf<Inverse>(entries[tab[slot]]), key)) {
+                slot = (slot + 1) & mask;
+            }
+
+            return slot;
+        }
+
+        /**
+         * Entry index of the key or Empty if the key cannot be found
+         */
+        template<bool Inverse>
+        Index indexOf(const std::conditional_t<Inverse, InverseKey, ForwardKey> &key) const {
+            const auto &tab = table<Inverse>();
+            return tab.empty() ? Empty : tab[findSlot<Inverse>(key)];
+        }
+
+        /**
+         * Backward shift deletion for linear probing
+         */
+        template<bool Inverse>
+        void removeSlot(std::size_t slot) {
+            auto &tab = table<Inverse>();
+            const auto mask = tab.size() - 1;
+            auto hole = slot;
+            for (auto curr = (slot + 1) & mask; tab[curr] != Empty; curr = (curr + 1) & mask) {
+                const auto desired = home<Inverse>(keyOf<Inverse>(entries[tab[curr]]));
+                // the entry may only be moved to the hole if the hole lies cyclically in [desired, curr)
+                const bool movable = hole <= curr ? (desired <= hole || desired > curr)
+                                                  : (desired <= hole && desired > curr);
+                if (movable) {
+                    tab[hole] = tab[curr];
+                    hole = curr;
+                }
+            }
+
+            tab[hole] = Empty;
+        }
+
+        void eraseIndex(Index index) {
+            removeSlot<false>(findSlot<false>(entries[index]->first));
+            removeSlot<true>(findSlot<true>(entries[index]->second));
+            entries[index].reset();
+            --numItems;
+            if (index + 1 == entries.size()) {
+                entries.pop_back();
+            } else if (2 * numItems < entries.size()) {
+                compact();
+            }
+        }
+
+        /**
+         * Inserts all entries into the empty tables
+         */
+        void reindex() {
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                if (entries[i]) {
+                    forwardTable[findSlot<false>(entries[i]->first)] = static_cast<Index>(i);
+                    inverseTable[findSlot<true>(entries[i]->second)] = static_cast<Index>(i);
+                }
+            }
+        }
+
+        std::vector<Entry> entries;
+        Table forwardTable;
+        Table inverseTable;
+        std::size_t numItems = 0;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_DENSE_BIDIRECTIONAL_MAP_HPP
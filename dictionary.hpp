@@ -0,0 +1,180 @@
+/**
+ * @file dictionary.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains functions for dictionary encoding of string columns using a bidirectional_map from
+ * strings to integer ids.
+ */
+
+#ifndef BIDIRECTIONALMAP_DICTIONARY_HPP
+#define BIDIRECTIONALMAP_DICTIONARY_HPP
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <limits>
+#include <iterator>
+#include <stdexcept>
+#include <cstdint>
+
+#include "bidirectional_map.hpp"
+#include "algorithms.hpp"
+
+namespace bimap::impl {
+    /**
+     * Calls fn(begin, end) for consecutive blocks covering the index range [0, size), possibly concurrently
+     * @param size number of indices
+     * @param numThreads maximum number of threads. The whole range is one block if this is 1
+     * @param fn function that is called with the index range of every block
+     */
+    template<typename Fn>
+    void for_each_block(std::size_t size, std::size_t numThreads, Fn &&fn) {
+        const std::size_t numBlocks = numThreads <= 1 ? 1 : std::min(size, numThreads * ChunksPerThread);
+        parallel_for(numBlocks, [size, numBlocks, &fn](std::size_t block) {
+            fn(block * size / numBlocks, (block + 1) * size / numBlocks);
+        }, numThreads);
+    }
+}
+
+namespace bimap {
+    /**
+     * Translates a column of strings into ids. Strings that are not yet contained in the dictionary are assigned the
+     * next free id, starting at dictionary.size(). With a parallel execution policy, the lookups of known strings are
+     * distributed over multiple threads. New ids are assigned afterwards by the calling thread in input order, so
+     * the result does not depend on the execution policy. Every distinct new string is hashed and inserted only once
+     * per call. All new ids are assigned before the first insertion, so if the ids run out the dictionary is left
+     * unchanged. The output may be partly written in that case.
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @tparam Id integral id type
+     * @tparam InputIt random access iterator type. Elements must be convertible to std::string_view
+     * @tparam OutputIt random access iterator type. Ids are assigned to its elements
+     * @param policy execution policy
+     * @param dictionary bidirectional_map from strings to ids
+     * @param first begin of the input column
+     * @param last end of the input column
+     * @param out begin of the output column. Must hold at least std::distance(first, last) elements
+     * @return number of newly assigned ids
+     * @throws std::overflow_error if the id type cannot represent all new ids. The dictionary is not modified
+     */
+    template<typename ExecutionPolicy, typename Id, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy, typename InputIt,
+             typename OutputIt>
+    auto encode(ExecutionPolicy &&policy,
+                bidirectional_map<std::string, Id, ForwardMapType, InverseMapType, LatencyPolicy> &dictionary,
+                InputIt first, InputIt last, OutputIt out)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>, std::size_t> {
+        static_assert(std::is_integral_v<Id>, "dictionary ids must be integral");
+        const auto size = static_cast<std::size_t>(std::distance(first, last));
+        std::vector<char> found(size, false);
+        impl::for_each_block(size, impl::concurrency_for(policy), [&](std::size_t begin, std::size_t end) {
+            // the buffer keeps its capacity such that lookups do not allocate
+            std::string key;
+            for (auto i = begin; i < end; ++i) {
+                key.assign(std::string_view(first[i]));
+                if (auto res = dictionary.find(key); res != dictionary.end()) {
+                    out[i] = res->second;
+                    found[i] = true;
+                }
+            }
+        });
+
+        std::unordered_map<std::string_view, Id> assigned;
+        // new strings in input order, inserted only once all of them have an id
+        std::vector<typename decltype(assigned)::const_pointer> newItems;
+        constexpr auto maxId = static_cast<std::uintmax_t>(std::numeric_limits<Id>::max());
+        std::uintmax_t nextId = dictionary.size();
+        for (std::size_t i = 0; i < size; ++i) {
+            if (found[i]) {
+                continue;
+            }
+
+            auto [it, inserted] = assigned.try_emplace(std::string_view(first[i]), Id{});
+            if (inserted) {
+                while (nextId <= maxId && dictionary.inverse().contains(static_cast<Id>(nextId))) {
+                    ++nextId;
+                }
+
+                if (nextId > maxId) {
+                    throw std::overflow_error("dictionary id space exhausted");
+                }
+
+                it->second = static_cast<Id>(nextId++);
+                newItems.emplace_back(&*it);
+            }
+
+            out[i] = it->second;
+        }
+
+        for (auto item : newItems) {
+            dictionary.emplace(std::string(item->first), item->second);
+        }
+
+        return assigned.size();
+    }
+
+    /**
+     * Sequential version of encode
+     * @param dictionary bidirectional_map from strings to ids
+     * @param first begin of the input column
+     * @param last end of the input column
+     * @param out begin of the output column. Must hold at least std::distance(first, last) elements
+     * @return number of newly assigned ids
+     * @throws std::overflow_error if the id type cannot represent all new ids. The dictionary is not modified
+     */
+    template<typename Id, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy, typename InputIt,
+             typename OutputIt>
+    std::size_t encode(bidirectional_map<std::string, Id, ForwardMapType, InverseMapType, LatencyPolicy> &dictionary,
+                       InputIt first, InputIt last, OutputIt out) {
+        return encode(std::execution::seq, dictionary, first, last, out);
+    }
+
+    /**
+     * Translates a column of ids back into strings. With a parallel execution policy, the lookups are distributed
+     * over multiple threads
+     * @tparam ExecutionPolicy one of the std::execution policies
+     * @tparam Id integral id type
+     * @tparam InputIt random access iterator type over ids
+     * @tparam OutputIt random access iterator type. Elements are assigned a const std::string &, so using
+     * std::string_view as output type avoids copies (the views are valid as long as the strings are in the dictionary)
+     * @param policy execution policy
+     * @param dictionary bidirectional_map from strings to ids
+     * @param first begin of the input column
+     * @param last end of the input column
+     * @param out begin of the output column. Must hold at least std::distance(first, last) elements
+     * @throws std::out_of_range if an id is not contained in the dictionary
+     */
+    template<typename ExecutionPolicy, typename Id, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy, typename InputIt,
+             typename OutputIt>
+    auto decode(ExecutionPolicy &&policy,
+                const bidirectional_map<std::string, Id, ForwardMapType, InverseMapType, LatencyPolicy> &dictionary,
+                InputIt first, InputIt last, OutputIt out)
+    -> std::enable_if_t<impl::traits::is_execution_policy<ExecutionPolicy>> {
+        const auto size = static_cast<std::size_t>(std::distance(first, last));
+        impl::for_each_block(size, impl::concurrency_for(policy), [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                out[i] = dictionary.inverse().at(first[i]);
+            }
+        });
+    }
+
+    /**
+     * Sequential version of decode
+     * @param dictionary bidirectional_map from strings to ids
+     * @param first begin of the input column
+     * @param last end of the input column
+     * @param out begin of the output column. Must hold at least std::distance(first, last) elements
+     * @throws std::out_of_range if an id is not contained in the dictionary
+     */
+    template<typename Id, template<typename ...> typename ForwardMapType,
+             template<typename ...> typename InverseMapType, typename LatencyPolicy, typename InputIt,
+             typename OutputIt>
+    void decode(const bidirectional_map<std::string, Id, ForwardMapType, InverseMapType, LatencyPolicy> &dictionary,
+                InputIt first, InputIt last, OutputIt out) {
+        decode(std::execution::seq, dictionary, first, last, out);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_DICTIONARY_HPP
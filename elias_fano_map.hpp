@@ -0,0 +1,476 @@
+/**
+ * @file elias_fano_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a compressed read only bidirectional map between sparse 64 bit keys and dense row ids
+ * using Elias-Fano encoding.
+ */
+
+#ifndef BIDIRECTIONALMAP_ELIAS_FANO_MAP_HPP
+#define BIDIRECTIONALMAP_ELIAS_FANO_MAP_HPP
+
+#include <vector>
+#include <bitset>
+#include <iterator>
+#include <optional>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+
+#include "bidirectional_map.hpp"
+#include "bidirectional_index_view.hpp"
+
+namespace bimap::impl {
+    /**
+     * Number of bits required to represent values in [0, maxValue]
+     */
+    constexpr unsigned bit_width(std::uint64_t maxValue) noexcept {
+        unsigned width = 0;
+        for (; maxValue != 0; maxValue >>= 1) {
+            ++width;
+        }
+
+        return width;
+    }
+
+    inline unsigned popcount(std::uint64_t word) noexcept {
+        return static_cast<unsigned>(std::bitset<64>(word).count());
+    }
+
+    /**
+     * @brief Array of unsigned integers of a fixed bit width that is packed into 64 bit words
+     */
+    class packed_vector {
+    public:
+        packed_vector() = default;
+
+        packed_vector(std::size_t size, unsigned width) : words((size * width + 63) / 64), width(width) {}
+
+        std::uint64_t get(std::size_t i) const noexcept {
+            if (width == 0) {
+                return 0;
+            }
+
+            const auto bit = i * width;
+            const auto word = bit / 64;
+            const auto offset = bit % 64;
+            auto res = words[word] >> offset;
+            if (offset + width > 64) {
+                res |= words[word + 1] << (64 - offset);
+            }
+
+            return width == 64 ? res : res & ((std::uint64_t(1) << width) - 1);
+        }
+
+        void set(std::size_t i, std::uint64_t value) noexcept {
+            if (width == 0) {
+                return;
+            }
+
+            const auto bit = i * width;
+            const auto word = bit / 64;
+            const auto offset = bit % 64;
+            const auto mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+            words[word] = (words[word] & ~(mask << offset)) | (value << offset);
+            if (offset + width > 64) {
+                const auto rest = 64 - offset;
+                words[word + 1] = (words[word + 1] & ~(mask >> rest)) | (value >> rest);
+            }
+        }
+
+        std::size_t size_in_bytes() const noexcept {
+            return words.size() * sizeof(std::uint64_t);
+        }
+
+    private:
+        std::vector<std::uint64_t> words;
+        unsigned width = 0;
+    };
+
+    /**
+     * @brief Bit vector with select queries. Stores the rank at the start of every block of 512 bits and the block
+     * of every SampleRate-th set and unset bit. Select jumps to the sampled block, skips whole blocks using the ranks
+     * and scans at most one block with popcount
+     */
+    class select_bit_vector {
+        static constexpr std::size_t SampleRate = 256;
+        static constexpr std::size_t WordsPerBlock = 8;
+        static constexpr std::size_t BlockBits = WordsPerBlock * 64;
+    public:
+        select_bit_vector() = default;
+
+        /**
+         * CTor
+         * @param words bits in 64 bit words, least significant bit first
+         */
+        explicit select_bit_vector(std::vector<std::uint64_t> words) : words(std::move(words)) {
+            const auto numBlocks = (this->words.size() + WordsPerBlock - 1) / WordsPerBlock;
+            blockRanks.resize(numBlocks + 1);
+            std::size_t ones = 0;
+            for (std::size_t pos = 0; pos < this->words.size() * 64; ++pos) {
+                if (pos % BlockBits == 0) {
+                    blockRanks[pos / BlockBits] = ones;
+                }
+
+                const bool bit = (this->words[pos / 64] >> (pos % 64)) & 1;
+                const auto rank = bit ? ones++ : pos - ones;
+                if (rank % SampleRate == 0) {
+                    (bit ? oneSamples : zeroSamples).push_back(static_cast<std::uint32_t>(pos / BlockBits));
+                }
+            }
+
+            blockRanks[numBlocks] = ones;
+        }
+
+        /**
+         * Position of the k-th (0 based) set or unset bit. The bit must exist
+         */
+        template<bool Bit>
+        std::size_t select(std::size_t k) const noexcept {
+            std::size_t block = (Bit ? oneSamples : zeroSamples)[k / SampleRate];
+            while (block + 1 < blockRanks.size() - 1 && rank<Bit>(block + 1) <= k) {
+                ++block;
+            }
+
+            auto before = rank<Bit>(block);
+            for (auto word = block * WordsPerBlock;; ++word) {
+                auto bits = Bit ? words[word] : ~words[word];
+                const auto count = popcount(bits);
+                if (before + count > k) {
+                    for (auto rest = k - before; rest > 0; --rest) {
+                        bits &= bits - 1;
+                    }
+
+                    return word * 64 + popcount((bits & (~bits + 1)) - 1);
+                }
+
+                before += count;
+            }
+        }
+
+        std::size_t size_in_bytes() const noexcept {
+            return (words.size() + blockRanks.size()) * sizeof(std::uint64_t) +
+                   (oneSamples.size() + zeroSamples.size()) * sizeof(std::uint32_t);
+        }
+
+    private:
+        /**
+         * Number of set or unset bits before the given block
+         */
+        template<bool Bit>
+        std::size_t rank(std::size_t block) const noexcept {
+            return Bit ? blockRanks[block] : block * BlockBits - blockRanks[block];
+        }
+
+        std::vector<std::uint64_t> words;
+        std::vector<std::uint64_t> blockRanks;
+        std::vector<std::uint32_t> oneSamples;
+        std::vector<std::uint32_t> zeroSamples;
+    };
+}
+
+namespace bimap {
+    /**
+     * @brief Compressed read only bidirectional map between unique 64 bit keys and dense row ids 0, ..., n - 1.
+     * @details The keys are sorted and stored with Elias-Fano encoding: the lower bits of every key are stored in a
+     * packed array and the upper bits in unary code in a bit vector with select support. The mapping between the
+     * position of a key in sorted order and its row is stored as a packed permutation in both directions. For
+     * sparse keys this requires a few bytes per pair:
+     * about 2 + log2(universe / n) bits per key plus 2 * log2(n) bits for the permutation.
+     * Key -> row locates the bucket of the upper bits with select and binary searches the lower bits within the
+     * bucket, row -> key takes O(1).
+     * ```
+     * std::vector<std::uint64_t> userIds = ...; // row i belongs to userIds[i]
+     * bimap::elias_fano_map<> map(userIds.begin(), userIds.end());
+     * auto row = map.at(userIds[3]); // 3
+     * map.inverse().at(3); // userIds[3]
+     * ```
+     * @tparam Row integral type of the row ids
+     */
+    template<typename Row = std::uint32_t>
+    class elias_fano_map {
+        static_assert(std::is_integral_v<Row>, "row ids must be integral");
+    public:
+        using key_type = std::uint64_t;
+
+        /**
+         * @brief forward iterator over the pairs (key, row) in key order
+         */
+        class iterator {
+        public:
+            using value_type = std::pair<key_type, Row>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            iterator(const elias_fano_map *map, std::size_t rank) noexcept: map(map), rank(rank) {}
+
+            reference operator*() const noexcept {
+                return {map->keyAt(rank), static_cast<Row>(map->rows.get(rank))};
+            }
+
+            pointer operator->() const noexcept {
+                return {**this};
+            }
+
+            iterator &operator++() noexcept {
+                ++rank;
+                return *this;
+            }
+
+            iterator operator++(int) noexcept {
+                auto tmp = *this;
+                ++rank;
+                return tmp;
+            }
+
+            bool operator==(const iterator &other) const noexcept {
+                return rank == other.rank && map == other.map;
+            }
+
+            bool operator!=(const iterator &other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            const elias_fano_map *map = nullptr;
+            std::size_t rank = 0;
+        };
+
+        /**
+         * @brief Lookup from rows to keys. Valid as long as the map exists
+         */
+        class inverse_view {
+        public:
+            explicit inverse_view(const elias_fano_map &map) noexcept: map(&map) {}
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                return map->size();
+            }
+
+            [[nodiscard]] bool empty() const noexcept {
+                return map->empty();
+            }
+
+            /**
+             * Check if a row exists
+             * @param row row used for lookup
+             * @return true if row is in [0, size())
+             */
+            bool contains(Row row) const noexcept {
+                if constexpr (std::is_signed_v<Row>) {
+                    if (row < 0) {
+                        return false;
+                    }
+                }
+
+                return static_cast<std::size_t>(row) < map->size();
+            }
+
+            /**
+             * Finds the key of a row in O(1)
+             * @param row row used for lookup
+             * @return key of the row or std::nullopt if row does not exist
+             */
+            std::optional<key_type> find(Row row) const noexcept {
+                if (!contains(row)) {
+                    return std::nullopt;
+                }
+
+                return map->keyAt(map->ranks.get(static_cast<std::size_t>(row)));
+            }
+
+            /**
+             * Returns the key of a row in O(1)
+             * @param row row used for lookup
+             * @return key of the row
+             * @throws std::out_of_range if row does not exist
+             */
+            key_type at(Row row) const {
+                auto res = find(row);
+                if (!res) {
+                    throw std::out_of_range("elias fano map row not found");
+                }
+
+                return *res;
+            }
+
+            /**
+             * Access to forward lookup
+             */
+            const elias_fano_map &inverse() const noexcept {
+                return *map;
+            }
+
+        private:
+            const elias_fano_map *map;
+        };
+
+        /**
+         * Creates an empty map
+         */
+        elias_fano_map() = default;
+
+        /**
+         * Builds the map from a key column. The i-th key is mapped to row i
+         * @tparam InputIt random access iterator type. Elements must be convertible to std::uint64_t
+         * @param first begin of the key column
+         * @param last end of the key column
+         * @throws std::invalid_argument if a key occurs more than once or if the number of keys exceeds the row range
+         */
+        template<typename InputIt>
+        elias_fano_map(InputIt first, InputIt last) : numKeys(static_cast<std::size_t>(std::distance(first, last))) {
+            if (numKeys > 0 && numKeys - 1 > static_cast<std::uintmax_t>(std::numeric_limits<Row>::max())) {
+                throw std::invalid_argument("too many keys for row type");
+            }
+
+            std::vector<std::size_t> order(numKeys);
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::sort(order.begin(), order.end(), [first](std::size_t lhs, std::size_t rhs) {
+                return static_cast<key_type>(first[lhs]) < static_cast<key_type>(first[rhs]);
+            });
+
+            if (numKeys == 0) {
+                return;
+            }
+
+            const auto maxKey = static_cast<key_type>(first[order.back()]);
+            lowBits = impl::bit_width(maxKey / numKeys);
+            lowBits = lowBits == 0 ? 0 : lowBits - 1;
+            const auto maxHigh = maxKey >> lowBits;
+            const auto rowBits = impl::bit_width(numKeys - 1);
+            lows = impl::packed_vector(numKeys, lowBits);
+            rows = impl::packed_vector(numKeys, rowBits);
+            ranks = impl::packed_vector(numKeys, rowBits);
+            std::vector<std::uint64_t> upper((numKeys + maxHigh + 1 + 63) / 64);
+            const auto lowMask = lowBits == 0 ? 0 : ~key_type(0) >> (64 - lowBits);
+            for (std::size_t rank = 0; rank < numKeys; ++rank) {
+                const auto key = static_cast<key_type>(first[order[rank]]);
+                if (rank > 0 && key == static_cast<key_type>(first[order[rank - 1]])) {
+                    throw std::invalid_argument("duplicate key in elias fano map");
+                }
+
+                const auto pos = (key >> lowBits) + rank;
+                upper[pos / 64] |= std::uint64_t(1) << (pos % 64);
+                lows.set(rank, key & lowMask);
+                rows.set(rank, order[rank]);
+                ranks.set(order[rank], rank);
+            }
+
+            highBuckets = maxHigh + 1;
+            high = impl::select_bit_vector(std::move(upper));
+        }
+
+        iterator begin() const noexcept {
+            return {this, 0};
+        }
+
+        iterator end() const noexcept {
+            return {this, numKeys};
+        }
+
+        /**
+         * Number of pairs
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return numKeys;
+        }
+
+        /**
+         * Whether the map is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return numKeys == 0;
+        }
+
+        /**
+         * Memory used by the encoded keys and the permutation in bytes
+         */
+        [[nodiscard]] std::size_t encoded_size() const noexcept {
+            return lows.size_in_bytes() + high.size_in_bytes() + rows.size_in_bytes() + ranks.size_in_bytes();
+        }
+
+        /**
+         * Finds the row of a key
+         * @param key key used for lookup
+         * @return row of the key or npos if key cannot be found
+         */
+        std::size_t find(key_type key) const noexcept {
+            const auto bucket = key >> lowBits;
+            if (numKeys == 0 || bucket >= highBuckets) {
+                return npos;
+            }
+
+            // keys with equal upper bits lie between two consecutive unset bits
+            auto lo = bucket == 0 ? 0 : high.select<false>(bucket - 1) + 1 - bucket;
+            const auto bucketEnd = high.select<false>(bucket) - bucket;
+            auto hi = bucketEnd;
+            const auto low = key ^ (bucket << lowBits);
+            while (lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+                if (lows.get(mid) < low) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+
+            return lo < bucketEnd && lows.get(lo) == low ? rows.get(lo) : npos;
+        }
+
+        /**
+         * Check if a certain key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        bool contains(key_type key) const noexcept {
+            return find(key) != npos;
+        }
+
+        /**
+         * Returns the row of a key
+         * @param key key used for lookup
+         * @return row of the key
+         * @throws std::out_of_range if key cannot be found
+         */
+        Row at(key_type key) const {
+            auto row = find(key);
+            if (row == npos) {
+                throw std::out_of_range("elias fano map key not found");
+            }
+
+            return static_cast<Row>(row);
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return view for lookup from rows to keys
+         */
+        inverse_view inverse() const noexcept {
+            return inverse_view(*this);
+        }
+
+    private:
+        /**
+         * Decodes the key at the given position in sorted order
+         */
+        key_type keyAt(std::size_t rank) const noexcept {
+            return (static_cast<key_type>(high.select<true>(rank) - rank) << lowBits) | lows.get(rank);
+        }
+
+        std::size_t numKeys = 0;
+        unsigned lowBits = 0;
+        std::uint64_t highBuckets = 0;
+        impl::packed_vector lows;
+        impl::select_bit_vector high;
+        impl::packed_vector rows;
+        impl::packed_vector ranks;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_ELIAS_FANO_MAP_HPP
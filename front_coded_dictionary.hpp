@@ -0,0 +1,407 @@
+/**
+ * @file front_coded_dictionary.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a compressed read only bidirectional map between sorted strings and their ids using
+ * front coding.
+ */
+
+#ifndef BIDIRECTIONALMAP_FRONT_CODED_DICTIONARY_HPP
+#define BIDIRECTIONALMAP_FRONT_CODED_DICTIONARY_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iterator>
+#include <optional>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+
+#include "bidirectional_map.hpp"
+#include "bidirectional_index_view.hpp"
+
+namespace bimap::impl {
+    /**
+     * Appends an unsigned integer in LEB128 encoding
+     */
+    inline void write_varint(std::vector<char> &out, std::size_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+
+        out.push_back(static_cast<char>(value));
+    }
+
+    /**
+     * Reads an unsigned integer in LEB128 encoding and advances the position
+     */
+    inline std::size_t read_varint(const char *&pos) noexcept {
+        std::size_t value = 0;
+        unsigned shift = 0;
+        unsigned char byte;
+        do {
+            byte = static_cast<unsigned char>(*pos++);
+            value |= static_cast<std::size_t>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        return value;
+    }
+}
+
+namespace bimap {
+    /**
+     * @brief Compressed read only bidirectional map between a sorted set of strings and their positions (ids).
+     * @details The strings are split into blocks of a fixed number of strings. The first string of every block (the
+     * head) is stored completely, all other strings only store the length of the prefix shared with their
+     * predecessor and the remaining suffix. Lengths are variable length encoded. For typical vocabularies this needs
+     * a fraction of the memory of a bidirectional_map<std::string, Id>.
+     * String -> id uses a binary search over the block heads and decodes at most one block. Id -> string decodes at
+     * most one block. Smaller blocks make lookups faster, larger blocks compress better.
+     * ```
+     * std::vector<std::string> words = {"apple", "apply", "banana"}; // sorted
+     * bimap::front_coded_dictionary<> dict(words.begin(), words.end());
+     * dict.at("apply"); // 1
+     * dict.inverse().at(2); // "banana"
+     * ```
+     * @tparam Id integral id type
+     */
+    template<typename Id = std::uint32_t>
+    class front_coded_dictionary {
+        static_assert(std::is_integral_v<Id>, "dictionary ids must be integral");
+    public:
+        /**
+         * @brief forward iterator over the pairs (id, string) in id order. Decodes the strings sequentially
+         */
+        class iterator {
+        public:
+            using value_type = std::pair<Id, std::string_view>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            iterator(const front_coded_dictionary *dict, std::size_t id) : dict(dict), id(id) {
+                if (id < dict->size()) {
+                    pos = dict->blockBegin(id / dict->blockSize);
+                    dict->decodeNext(pos, true, current);
+                }
+            }
+
+            reference operator*() const noexcept {
+                return {static_cast<Id>(id), current};
+            }
+
+            pointer operator->() const noexcept {
+                return {**this};
+            }
+
+            iterator &operator++() {
+                ++id;
+                if (id < dict->size()) {
+                    dict->decodeNext(pos, id % dict->blockSize == 0, current);
+                }
+
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const iterator &other) const noexcept {
+                return id == other.id && dict == other.dict;
+            }
+
+            bool operator!=(const iterator &other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            const front_coded_dictionary *dict = nullptr;
+            std::size_t id = 0;
+            const char *pos = nullptr;
+            std::string current;
+        };
+
+        /**
+         * @brief Lookup from ids to strings. Valid as long as the dictionary exists
+         */
+        class inverse_view {
+        public:
+            explicit inverse_view(const front_coded_dictionary &dict) noexcept: dict(&dict) {}
+
+            iterator begin() const {
+                return dict->begin();
+            }
+
+            iterator end() const {
+                return dict->end();
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                return dict->size();
+            }
+
+            [[nodiscard]] bool empty() const noexcept {
+                return dict->empty();
+            }
+
+            /**
+             * Check if an id is assigned
+             * @param id id used for lookup
+             * @return true if id is in [0, size())
+             */
+            bool contains(Id id) const noexcept {
+                if constexpr (std::is_signed_v<Id>) {
+                    if (id < 0) {
+                        return false;
+                    }
+                }
+
+                return static_cast<std::size_t>(id) < dict->size();
+            }
+
+            /**
+             * Decodes the string with the given id
+             * @param id id used for lookup
+             * @return the string or std::nullopt if id is not assigned
+             */
+            std::optional<std::string> find(Id id) const {
+                if (!contains(id)) {
+                    return std::nullopt;
+                }
+
+                std::string res;
+                dict->decode(static_cast<std::size_t>(id), res);
+                return res;
+            }
+
+            /**
+             * Decodes the string with the given id
+             * @param id id used for lookup
+             * @return the string
+             * @throws std::out_of_range if id is not assigned
+             */
+            std::string at(Id id) const {
+                auto res = find(id);
+                if (!res) {
+                    throw std::out_of_range("front coded dictionary id not found");
+                }
+
+                return std::move(*res);
+            }
+
+            /**
+             * Access to forward lookup
+             */
+            const front_coded_dictionary &inverse() const noexcept {
+                return *dict;
+            }
+
+        private:
+            const front_coded_dictionary *dict;
+        };
+
+        /**
+         * Creates an empty dictionary
+         */
+        front_coded_dictionary() = default;
+
+        /**
+         * Builds the dictionary. The i-th string is assigned the id i
+         * @tparam InputIt input iterator type. Elements must be convertible to std::string_view
+         * @param first begin of the strings
+         * @param last end of the strings
+         * @param blockSize number of strings per block
+         * @throws std::invalid_argument if the strings are not strictly increasing, if blockSize is 0 or if the
+         * number of strings exceeds the id range
+         */
+        template<typename InputIt>
+        front_coded_dictionary(InputIt first, InputIt last, std::size_t blockSize = 16) : blockSize(blockSize) {
+            if (blockSize == 0) {
+                throw std::invalid_argument("block size must not be zero");
+            }
+
+            std::string previous;
+            for (; first != last; ++first, ++numStrings) {
+                std::string_view str(*first);
+                if (numStrings > 0 && !(previous < str)) {
+                    throw std::invalid_argument("strings are not sorted or not unique");
+                }
+
+                if (numStrings > static_cast<std::uintmax_t>(std::numeric_limits<Id>::max())) {
+                    throw std::invalid_argument("too many strings for id type");
+                }
+
+                std::size_t shared = 0;
+                if (numStrings % blockSize == 0) {
+                    blockOffsets.push_back(data.size());
+                } else {
+                    const auto maxShared = std::min(previous.size(), str.size());
+                    while (shared < maxShared && previous[shared] == str[shared]) {
+                        ++shared;
+                    }
+
+                    impl::write_varint(data, shared);
+                }
+
+                impl::write_varint(data, str.size() - shared);
+                data.insert(data.end(), str.begin() + static_cast<std::ptrdiff_t>(shared), str.end());
+                previous.assign(str);
+            }
+
+            data.shrink_to_fit();
+            blockOffsets.shrink_to_fit();
+        }
+
+        iterator begin() const {
+            return iterator(this, 0);
+        }
+
+        iterator end() const {
+            return iterator(this, numStrings);
+        }
+
+        /**
+         * Number of strings
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return numStrings;
+        }
+
+        /**
+         * Whether the dictionary is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return numStrings == 0;
+        }
+
+        /**
+         * Size of the encoded strings and the block offsets in bytes
+         */
+        [[nodiscard]] std::size_t encoded_size() const noexcept {
+            return data.size() + blockOffsets.size() * sizeof(std::size_t);
+        }
+
+        /**
+         * Finds the id of a string
+         * @param str string used for lookup
+         * @return id of the string or npos if the string cannot be found
+         */
+        std::size_t find(std::string_view str) const {
+            // last block whose head is not greater than str
+            std::size_t lo = 0;
+            std::size_t hi = blockOffsets.size();
+            while (lo < hi) {
+                const auto mid = lo + (hi - lo) / 2;
+                if (str < head(mid)) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+
+            if (lo == 0) {
+                return npos;
+            }
+
+            const auto block = lo - 1;
+            const auto blockEnd = std::min(numStrings, (block + 1) * blockSize);
+            const char *pos = blockBegin(block);
+            std::string current;
+            for (std::size_t id = block * blockSize; id < blockEnd; ++id) {
+                decodeNext(pos, id == block * blockSize, current);
+                const auto cmp = std::string_view(current).compare(str);
+                if (cmp == 0) {
+                    return id;
+                }
+
+                if (cmp > 0) {
+                    break;
+                }
+            }
+
+            return npos;
+        }
+
+        /**
+         * Check if a certain string can be found
+         * @param str string used for lookup
+         * @return true if str can be found, false otherwise
+         */
+        bool contains(std::string_view str) const {
+            return find(str) != npos;
+        }
+
+        /**
+         * Returns the id of a string
+         * @param str string used for lookup
+         * @return id of str
+         * @throws std::out_of_range if str cannot be found
+         */
+        Id at(std::string_view str) const {
+            auto id = find(str);
+            if (id == npos) {
+                throw std::out_of_range("front coded dictionary key not found");
+            }
+
+            return static_cast<Id>(id);
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return view for lookup from ids to strings
+         */
+        inverse_view inverse() const noexcept {
+            return inverse_view(*this);
+        }
+
+    private:
+        const char *blockBegin(std::size_t block) const noexcept {
+            return data.data() + blockOffsets[block];
+        }
+
+        std::string_view head(std::size_t block) const noexcept {
+            const char *pos = blockBegin(block);
+            const auto length = impl::read_varint(pos);
+            return {pos, length};
+        }
+
+        /**
+         * Decodes the string at pos given its predecessor in current and advances pos
+         */
+        void decodeNext(const char *&pos, bool isHead, std::string &current) const {
+            const auto shared = isHead ? 0 : impl::read_varint(pos);
+            const auto suffix = impl::read_varint(pos);
+            current.resize(shared);
+            current.append(pos, suffix);
+            pos += suffix;
+        }
+
+        /**
+         * Decodes the string with the given id
+         */
+        void decode(std::size_t id, std::string &out) const {
+            const auto block = id / blockSize;
+            const char *pos = blockBegin(block);
+            for (std::size_t curr = block * blockSize; curr <= id; ++curr) {
+                decodeNext(pos, curr == block * blockSize, out);
+            }
+        }
+
+        std::size_t blockSize = 16;
+        std::size_t numStrings = 0;
+        std::vector<char> data;
+        std::vector<std::size_t> blockOffsets;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_FRONT_CODED_DICTIONARY_HPP
@@ -0,0 +1,411 @@
+/**
+ * @file instrumented_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a base container wrapper that collects lookup, insertion and hashing statistics. It can
+ * be used as base container for bimap::bidirectional_map.
+ */
+
+#ifndef BIDIRECTIONALMAP_INSTRUMENTED_MAP_HPP
+#define BIDIRECTIONALMAP_INSTRUMENTED_MAP_HPP
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap::impl {
+    namespace traits {
+        template<typename T, typename = std::void_t<>>
+        struct has_hash_buckets : std::false_type {};
+
+        template<typename T>
+        struct has_hash_buckets<T, std::void_t<decltype(std::declval<const T &>().bucket_count()),
+                decltype(std::declval<const T &>().bucket_size(std::size_t{})),
+                decltype(std::declval<const T &>().bucket(std::declval<const typename T::key_type &>())),
+                decltype(std::declval<const T &>().max_load_factor())>> : std::true_type {};
+    }
+
+    /**
+     * @brief Copyable counter that can be updated concurrently. All operations use relaxed memory order
+     */
+    class relaxed_counter {
+    public:
+        constexpr relaxed_counter() noexcept = default;
+
+        relaxed_counter(const relaxed_counter &other) noexcept: value(other.load()) {}
+
+        relaxed_counter &operator=(const relaxed_counter &other) noexcept {
+            value.store(other.load(), std::memory_order_relaxed);
+            return *this;
+        }
+
+        void add(std::size_t amount) noexcept {
+            value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        void update_max(std::size_t candidate) noexcept {
+            auto curr = load();
+            while (curr < candidate && !value.compare_exchange_weak(curr, candidate, std::memory_order_relaxed)) {}
+        }
+
+        [[nodiscard]] std::size_t load() const noexcept {
+            return value.load(std::memory_order_relaxed);
+        }
+
+        void swap(relaxed_counter &other) noexcept {
+            const auto tmp = load();
+            value.store(other.load(), std::memory_order_relaxed);
+            other.value.store(tmp, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::size_t> value{0};
+    };
+}
+
+namespace bimap {
+    /**
+     * @brief Snapshot of the statistics of one lookup direction
+     */
+    struct map_statistics {
+        /// Number of bins in the bucket occupancy histogram
+        static constexpr std::size_t occupancy_bins = 8;
+
+        /// Number of lookups (find, count, equal_range, lower_bound, upper_bound, erase by key)
+        std::size_t lookups = 0;
+        /// Number of successful insertions
+        std::size_t insertions = 0;
+        /// Number of emplace calls on the bidirectional_map rejected because the forward key was already contained
+        std::size_t forward_conflicts = 0;
+        /// Number of emplace calls on the bidirectional_map rejected because the inverse key was already contained
+        std::size_t inverse_conflicts = 0;
+        /// Sum of the chain lengths of the buckets probed by lookups. Only recorded for hash based containers
+        std::size_t probes = 0;
+        /// Longest chain probed by a lookup. Only recorded for hash based containers
+        std::size_t max_probe_length = 0;
+        /// Largest number of elements with the same key seen on insertion. Only recorded for multimaps
+        std::size_t max_fan_out = 0;
+        /// Number of insertions or reserve calls that changed the bucket count
+        std::size_t rehashes = 0;
+        /// Total duration of these insertions and reserve calls
+        std::chrono::nanoseconds rehash_time{0};
+        /// Current number of buckets. 0 if the container is not hash based
+        std::size_t bucket_count = 0;
+        /// Current load factor. 0 if the container is not hash based
+        double load_factor = 0;
+        /// bucket_occupancy[i] is the number of buckets with i elements, the last bin also counts fuller buckets
+        std::array<std::size_t, occupancy_bins> bucket_occupancy{};
+
+        /**
+         * Average chain length probed by lookups
+         */
+        [[nodiscard]] double average_probe_length() const noexcept {
+            return lookups == 0 ? 0 : static_cast<double>(probes) / static_cast<double>(lookups);
+        }
+    };
+
+    /**
+     * @brief Wrapper around a base container that records statistics about lookups, insertions and rehashing.
+     * @details All counters are updated with relaxed atomic operations, so concurrent lookups remain possible. Probe
+     * lengths, load factor, bucket occupancy and rehashes are only available for containers with a bucket interface
+     * like std::unordered_map. The probe length of a lookup is the number of elements in the bucket of the key, which
+     * costs an additional pass over that bucket. Conflict counters are updated by bidirectional_map::emplace.
+     * Optional members of the wrapped container other than lower_bound, upper_bound, key_comp and reserve are not
+     * forwarded. Statistics are collected only if this wrapper is used, all other base containers are unaffected:
+     * ```
+     * using Stats = bimap::instrumented<std::unordered_map>;
+     * bimap::bidirectional_map<std::string, int, Stats::type, Stats::type> map;
+     * map.emplace("a", 1);
+     * map.emplace("b", 1); // inverse conflict
+     * auto forward = map.statistics();
+     * auto inverse = map.inverse().statistics();
+     * ```
+     * @tparam Map wrapped container type
+     */
+    template<typename Map>
+    class instrumented_map {
+        using Clock = std::chrono::steady_clock;
+        static constexpr bool Hashed = impl::traits::has_hash_buckets<Map>::value;
+    public:
+        using key_type = typename Map::key_type;
+        using mapped_type = typename Map::mapped_type;
+        using value_type = typename Map::value_type;
+        using size_type = typename Map::size_type;
+        using difference_type = typename Map::difference_type;
+        using iterator = typename Map::iterator;
+        using const_iterator = typename Map::const_iterator;
+
+        iterator begin() noexcept {
+            return map.begin();
+        }
+
+        const_iterator begin() const noexcept {
+            return map.begin();
+        }
+
+        iterator end() noexcept {
+            return map.end();
+        }
+
+        const_iterator end() const noexcept {
+            return map.end();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return map.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return map.empty();
+        }
+
+        void clear() noexcept(noexcept(std::declval<Map &>().clear())) {
+            map.clear();
+        }
+
+        /**
+         * Calls emplace on the wrapped container and records the insertion. Insertions that change the bucket count
+         * are timed
+         * @tparam ARGS argument types
+         * @param args arguments forwarded to the wrapped container
+         * @return result of the wrapped emplace
+         */
+        template<typename ...ARGS>
+        decltype(auto) emplace(ARGS &&...args) {
+            if constexpr (Hashed) {
+                const auto buckets = map.bucket_count();
+                if (static_cast<float>(map.size() + 1) > map.max_load_factor() * static_cast<float>(buckets)) {
+                    const auto start = Clock::now();
+                    decltype(auto) res = map.emplace(std::forward<ARGS>(args)...);
+                    recordRehash(buckets, start);
+                    recordInsertion(res);
+                    return res;
+                }
+            }
+
+            decltype(auto) res = map.emplace(std::forward<ARGS>(args)...);
+            recordInsertion(res);
+            return res;
+        }
+
+        iterator erase(const_iterator pos) {
+            return map.erase(pos);
+        }
+
+        size_type erase(const key_type &key) {
+            recordLookup(key);
+            return map.erase(key);
+        }
+
+        iterator find(const key_type &key) {
+            recordLookup(key);
+            return map.find(key);
+        }
+
+        const_iterator find(const key_type &key) const {
+            recordLookup(key);
+            return map.find(key);
+        }
+
+        size_type count(const key_type &key) const {
+            recordLookup(key);
+            return map.count(key);
+        }
+
+        auto equal_range(const key_type &key) {
+            recordLookup(key);
+            return map.equal_range(key);
+        }
+
+        auto equal_range(const key_type &key) const {
+            recordLookup(key);
+            return map.equal_range(key);
+        }
+
+        template<REQUIRES_THAT(Map, std::declval<_T_ &>().lower_bound(std::declval<key_type>()))>
+        iterator lower_bound(const key_type &key) {
+            recordLookup(key);
+            return map.lower_bound(key);
+        }
+
+        template<REQUIRES_THAT(Map, std::declval<const _T_ &>().lower_bound(std::declval<key_type>()))>
+        const_iterator lower_bound(const key_type &key) const {
+            recordLookup(key);
+            return map.lower_bound(key);
+        }
+
+        template<REQUIRES_THAT(Map, std::declval<_T_ &>().upper_bound(std::declval<key_type>()))>
+        iterator upper_bound(const key_type &key) {
+            recordLookup(key);
+            return map.upper_bound(key);
+        }
+
+        template<REQUIRES_THAT(Map, std::declval<const _T_ &>().upper_bound(std::declval<key_type>()))>
+        const_iterator upper_bound(const key_type &key) const {
+            recordLookup(key);
+            return map.upper_bound(key);
+        }
+
+        template<REQUIRES_THAT(Map, std::declval<const _T_ &>().key_comp())>
+        auto key_comp() const {
+            return map.key_comp();
+        }
+
+        /**
+         * Calls reserve on the wrapped container. Calls that change the bucket count are recorded as rehash
+         * @param count number of elements
+         */
+        template<REQUIRES_THAT(Map, std::declval<_T_ &>().reserve(std::size_t{}))>
+        void reserve(size_type count) {
+            if constexpr (Hashed) {
+                const auto buckets = map.bucket_count();
+                const auto start = Clock::now();
+                map.reserve(count);
+                recordRehash(buckets, start);
+            } else {
+                map.reserve(count);
+            }
+        }
+
+        /**
+         * Called by bidirectional_map::emplace when an insertion is rejected
+         * @param inverseKey true if the inverse key was already contained, false if the forward key was
+         */
+        void record_conflict(bool inverseKey) noexcept {
+            (inverseKey ? inverseConflicts : forwardConflicts).add(1);
+        }
+
+        /**
+         * Snapshot of the collected statistics. Computing the bucket occupancy histogram visits every bucket once
+         * @return current statistics
+         */
+        [[nodiscard]] map_statistics statistics() const {
+            map_statistics ret;
+            ret.lookups = lookups.load();
+            ret.insertions = insertions.load();
+            ret.forward_conflicts = forwardConflicts.load();
+            ret.inverse_conflicts = inverseConflicts.load();
+            ret.probes = probes.load();
+            ret.max_probe_length = maxProbeLength.load();
+            ret.max_fan_out = maxFanOut.load();
+            ret.rehashes = rehashes.load();
+            ret.rehash_time = std::chrono::nanoseconds(rehashTime.load());
+            if constexpr (Hashed) {
+                ret.bucket_count = map.bucket_count();
+                ret.load_factor = static_cast<double>(map.size()) / static_cast<double>(ret.bucket_count);
+                for (std::size_t bucket = 0; bucket < ret.bucket_count; ++bucket) {
+                    const auto occupancy = static_cast<std::size_t>(map.bucket_size(bucket));
+                    ++ret.bucket_occupancy[std::min(occupancy, map_statistics::occupancy_bins - 1)];
+                }
+            }
+
+            return ret;
+        }
+
+        /**
+         * Resets all counters
+         */
+        void reset_statistics() noexcept {
+            for (auto counter : counters()) {
+                *counter = impl::relaxed_counter();
+            }
+        }
+
+        /**
+         * Swaps the contents and the statistics of the containers
+         * @param other swap target
+         */
+        void swap(instrumented_map &other) noexcept(std::is_nothrow_swappable_v<Map>) {
+            using std::swap;
+            swap(map, other.map);
+            auto otherCounters = other.counters();
+            for (std::size_t i = 0; i < otherCounters.size(); ++i) {
+                counters()[i]->swap(*otherCounters[i]);
+            }
+        }
+
+        bool operator==(const instrumented_map &other) const {
+            return map == other.map;
+        }
+
+        bool operator!=(const instrumented_map &other) const {
+            return map != other.map;
+        }
+
+    private:
+        std::array<impl::relaxed_counter *, 9> counters() noexcept {
+            return {&lookups, &probes, &maxProbeLength, &insertions, &forwardConflicts, &inverseConflicts, &maxFanOut,
+                    &rehashes, &rehashTime};
+        }
+
+        void recordLookup(const key_type &key) const {
+            lookups.add(1);
+            if constexpr (Hashed) {
+                const auto probeLength = static_cast<std::size_t>(map.bucket_size(map.bucket(key)));
+                probes.add(probeLength);
+                maxProbeLength.update_max(probeLength);
+            }
+        }
+
+        template<typename Result>
+        void recordInsertion(const Result &res) {
+            if constexpr (impl::traits::is_multimap_v<Map>) {
+                insertions.add(1);
+                maxFanOut.update_max(static_cast<std::size_t>(map.count(res->first)));
+            } else if (res.second) {
+                insertions.add(1);
+            }
+        }
+
+        void recordRehash(std::size_t oldBucketCount, Clock::time_point start) {
+            if (map.bucket_count() != oldBucketCount) {
+                rehashes.add(1);
+                rehashTime.add(static_cast<std::size_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+            }
+        }
+
+        Map map;
+        mutable impl::relaxed_counter lookups;
+        mutable impl::relaxed_counter probes;
+        mutable impl::relaxed_counter maxProbeLength;
+        impl::relaxed_counter insertions;
+        impl::relaxed_counter forwardConflicts;
+        impl::relaxed_counter inverseConflicts;
+        impl::relaxed_counter maxFanOut;
+        impl::relaxed_counter rehashes;
+        impl::relaxed_counter rehashTime;
+    };
+
+    /**
+     * @brief Adapts a base container template for use with bidirectional_map such that statistics are collected
+     * @tparam MapType base container template, for example std::unordered_map
+     */
+    template<template<typename ...> typename MapType>
+    struct instrumented {
+        template<typename ...ARGS>
+        using type = instrumented_map<MapType<ARGS...>>;
+    };
+
+    /**
+     * See member function instrumented_map::swap
+     * @param lhs left hand side
+     * @param rhs right hand side
+     */
+    template<typename Map>
+    void swap(instrumented_map<Map> &lhs, instrumented_map<Map> &rhs) noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+}
+
+namespace bimap::impl::traits {
+    template<typename Map>
+    struct is_multimap<instrumented_map<Map>> : is_multimap<Map> {};
+}
+
+#endif //BIDIRECTIONALMAP_INSTRUMENTED_MAP_HPP
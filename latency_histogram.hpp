@@ -0,0 +1,241 @@
+/**
+ * @file latency_histogram.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a lock-free latency histogram and a latency policy for bimap::bidirectional_map that
+ * records emplace, erase and find latencies.
+ */
+
+#ifndef BIDIRECTIONALMAP_LATENCY_HISTOGRAM_HPP
+#define BIDIRECTIONALMAP_LATENCY_HISTOGRAM_HPP
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BIDIRECTIONALMAP_HAS_TSC
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#define BIDIRECTIONALMAP_HAS_TSC
+#endif
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Lock-free histogram with logarithmic bucket sizes like HdrHistogram.
+     * @details Values below 2 * sub_buckets are counted exactly. Above that, every power of two range is split into
+     * sub_buckets equally sized buckets, so the relative error of reported values is at most 1 / sub_buckets. Any
+     * number of threads can record concurrently, recording is a single relaxed atomic increment. Reading while
+     * recording is possible but may produce slightly inconsistent results
+     */
+    class latency_histogram {
+        static constexpr unsigned SubBucketBits = 5;
+    public:
+        /// Number of buckets per power of two
+        static constexpr std::size_t sub_buckets = std::size_t(1) << SubBucketBits;
+        /// Total number of buckets covering all 64 bit values
+        static constexpr std::size_t bucket_count = (65 - SubBucketBits) * sub_buckets;
+
+        latency_histogram() = default;
+        latency_histogram(const latency_histogram &) = delete;
+        latency_histogram &operator=(const latency_histogram &) = delete;
+
+        /**
+         * Records a value
+         * @param value value to record
+         */
+        void record(std::uint64_t value) noexcept {
+            counts[index_of(value)].fetch_add(1, std::memory_order_relaxed);
+            auto curr = maxValue.load(std::memory_order_relaxed);
+            while (curr < value && !maxValue.compare_exchange_weak(curr, value, std::memory_order_relaxed)) {}
+        }
+
+        /**
+         * Number of recorded values
+         */
+        [[nodiscard]] std::uint64_t count() const noexcept {
+            std::uint64_t ret = 0;
+            for (const auto &bucket : counts) {
+                ret += bucket.load(std::memory_order_relaxed);
+            }
+
+            return ret;
+        }
+
+        /**
+         * Largest recorded value
+         */
+        [[nodiscard]] std::uint64_t max() const noexcept {
+            return maxValue.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Value at the given quantile
+         * @param quantile quantile in [0, 1], for example 0.999 for the 99.9th percentile
+         * @return upper bound of the bucket containing the quantile, but at most max(). 0 if the histogram is empty
+         */
+        [[nodiscard]] std::uint64_t value_at(double quantile) const noexcept {
+            const auto total = count();
+            if (total == 0) {
+                return 0;
+            }
+
+            const auto clamped = std::clamp(quantile, 0.0, 1.0);
+            const auto rank = std::max<std::uint64_t>(
+                    1, static_cast<std::uint64_t>(clamped * static_cast<double>(total) + 0.5));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; ++i) {
+                seen += counts[i].load(std::memory_order_relaxed);
+                if (seen >= rank) {
+                    return std::min(upper_bound_of(i), max());
+                }
+            }
+
+            return max();
+        }
+
+        /**
+         * Resets all counts
+         */
+        void reset() noexcept {
+            for (auto &bucket : counts) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+
+            maxValue.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * Bucket index of a value
+         */
+        static constexpr std::size_t index_of(std::uint64_t value) noexcept {
+            unsigned shift = 0;
+            while ((value >> shift) >= 2 * sub_buckets) {
+                ++shift;
+            }
+
+            return shift * sub_buckets + static_cast<std::size_t>(value >> shift);
+        }
+
+        /**
+         * Largest value that falls into the given bucket
+         */
+        static constexpr std::uint64_t upper_bound_of(std::size_t index) noexcept {
+            const auto shift = index < 2 * sub_buckets ? 0 : index / sub_buckets - 1;
+            const auto sub = index - shift * sub_buckets;
+            return ((static_cast<std::uint64_t>(sub) + 1) << shift) - 1;
+        }
+
+    private:
+        std::array<std::atomic<std::uint64_t>, bucket_count> counts{};
+        std::atomic<std::uint64_t> maxValue{0};
+    };
+
+    /**
+     * @brief Latency policy for bidirectional_map that records emplace, erase and find latencies into one
+     * latency_histogram per operation and direction.
+     * @details Timestamps are read from the time stamp counter where available (x86), otherwise from
+     * std::chrono::steady_clock in nanoseconds. The time stamp counter is not serialized, so single measurements can
+     * be off by a few dozen cycles. Histograms are shared by all maps using the same policy type, use different tags to
+     * keep the histograms of different maps apart. Emplace includes its internal lookups, which are not recorded as
+     * find.
+     * ```
+     * struct Tag {};
+     * using Policy = bimap::latency_histogram_policy<Tag>;
+     * bimap::bidirectional_map<std::string, int, std::unordered_map, std::unordered_map, Policy> map;
+     * map.emplace("a", 1);
+     * map.inverse().find(1); // recorded as inverse find
+     * Policy::write_text(std::cout);
+     * ```
+     * @tparam Tag arbitrary type used to separate histograms
+     */
+    template<typename Tag = void>
+    struct latency_histogram_policy {
+        static constexpr bool enabled = true;
+
+        /**
+         * Current timestamp
+         * @return time stamp counter value or nanoseconds
+         */
+        static std::uint64_t now() noexcept {
+#ifdef BIDIRECTIONALMAP_HAS_TSC
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        /**
+         * Unit of recorded values
+         */
+        static constexpr const char *unit() noexcept {
+#ifdef BIDIRECTIONALMAP_HAS_TSC
+            return "cycles";
+#else
+            return "ns";
+#endif
+        }
+
+        /**
+         * Called by bidirectional_map after an operation
+         * @param op operation
+         * @param inverse whether the operation was called through inverse()
+         * @param ticks duration of the operation
+         */
+        static void record(map_operation op, bool inverse, std::uint64_t ticks) noexcept {
+            histogram(op, inverse).record(ticks);
+        }
+
+        /**
+         * Access to a histogram
+         * @param op operation
+         * @param inverse direction
+         * @return histogram of the given operation and direction
+         */
+        static latency_histogram &histogram(map_operation op, bool inverse) noexcept {
+            return histograms[static_cast<std::size_t>(op)][inverse];
+        }
+
+        /**
+         * Resets all histograms
+         */
+        static void reset() noexcept {
+            for (auto &perOperation : histograms) {
+                for (auto &hist : perOperation) {
+                    hist.reset();
+                }
+            }
+        }
+
+        /**
+         * Writes a summary line per operation and direction:
+         * `<operation> <direction> count=<n> p50=<v> p90=<v> p99=<v> p99.9=<v> max=<v> unit=<unit>`
+         * @param out output stream
+         */
+        static void write_text(std::ostream &out) {
+            constexpr std::array<const char *, NumOperations> Names = {"emplace", "erase", "find"};
+            for (std::size_t op = 0; op < NumOperations; ++op) {
+                for (bool inverse : {false, true}) {
+                    const auto &hist = histograms[op][inverse];
+                    out << Names[op] << (inverse ? " inverse" : " forward") << " count=" << hist.count()
+                        << " p50=" << hist.value_at(0.5) << " p90=" << hist.value_at(0.9)
+                        << " p99=" << hist.value_at(0.99) << " p99.9=" << hist.value_at(0.999)
+                        << " max=" << hist.max() << " unit=" << unit() << '\n';
+                }
+            }
+        }
+
+    private:
+        static constexpr std::size_t NumOperations = 3;
+        inline static std::array<std::array<latency_histogram, 2>, NumOperations> histograms{};
+    };
+}
+
+#endif //BIDIRECTIONALMAP_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,442 @@
+/**
+ * @file lazy_bidirectional_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a bidirectional map that defers maintenance of the inverse lookup until it is needed.
+ */
+
+#ifndef BIDIRECTIONALMAP_LAZY_BIDIRECTIONAL_MAP_HPP
+#define BIDIRECTIONALMAP_LAZY_BIDIRECTIONAL_MAP_HPP
+
+#include <unordered_map>
+#include <vector>
+#include <iterator>
+#include <utility>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Bidirectional map for write heavy build phases that updates its inverse lookup in bulk.
+     * @details Insertion and erasure only update the forward container. Newly inserted pairs are recorded in a
+     * pending list and inserted into the inverse container by sync(), which non-const inverse() calls
+     * implicitly. The inverse container is reserved once for all pending pairs if it supports reserve.
+     * Forward keys are always unique. Uniqueness of inverse keys is checked during sync: a pending pair whose
+     * inverse key is already contained is removed, exactly as emplace on a bidirectional_map would have rejected it,
+     * and returned to the caller. Pending pairs are synced in insertion order.
+     * ```
+     * bimap::lazy_bidirectional_map<std::string, int> map;
+     * map.emplace("a", 1); // no inverse lookup happens
+     * map.emplace("b", 1);
+     * auto rejected = map.sync(); // {("b", 1)}
+     * map.inverse().at(1); // "a"
+     * ```
+     * @tparam ForwardKey type of forward keys
+     * @tparam InverseKey type of inverse keys. Inverse keys are stored twice, so they must be copy constructible
+     * @tparam ForwardMapType container used for forward lookup. Must not be a multimap and must not invalidate
+     * references to its elements on insertion (like all std associative containers)
+     * @tparam InverseMapType container used for inverse lookup. Must not be a multimap
+     */
+    template<typename ForwardKey, typename InverseKey,
+             template<typename ...> typename ForwardMapType = std::unordered_map,
+             template<typename ...> typename InverseMapType = std::unordered_map>
+    class lazy_bidirectional_map {
+        static constexpr std::size_t Synced = std::numeric_limits<std::size_t>::max();
+        static constexpr std::size_t MinPending = 16;
+
+        struct Entry {
+            template<typename ...ARGS>
+            explicit Entry(ARGS &&...args) : value(std::forward<ARGS>(args)...) {}
+
+            InverseKey value;
+            // position in the pending list or Synced
+            std::size_t pendingPos = Synced;
+        };
+
+        using ForwardMap = ForwardMapType<ForwardKey, Entry>;
+        using InverseMap = InverseMapType<InverseKey, const ForwardKey *>;
+        using Node = typename ForwardMap::value_type;
+        static_assert(!impl::traits::is_multimap_v<ForwardMap> && !impl::traits::is_multimap_v<InverseMap>,
+                      "lazy_bidirectional_map does not support multimaps");
+
+        template<typename BaseIt, bool Inverse>
+        class Iterator {
+            friend class lazy_bidirectional_map;
+            using Key = std::conditional_t<Inverse, InverseKey, ForwardKey>;
+            using Value = std::conditional_t<Inverse, ForwardKey, InverseKey>;
+        public:
+            using value_type = std::pair<const Key &, const Value &>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = typename std::iterator_traits<BaseIt>::difference_type;
+            using iterator_category = typename std::iterator_traits<BaseIt>::iterator_category;
+
+            Iterator() = default;
+
+            explicit Iterator(BaseIt it) : it(it) {}
+
+            reference operator*() const {
+                if constexpr (Inverse) {
+                    return {it->first, *it->second};
+                } else {
+                    return {it->first, it->second.value};
+                }
+            }
+
+            pointer operator->() const {
+                return {**this};
+            }
+
+            Iterator &operator++() {
+                ++it;
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto tmp = *this;
+                ++it;
+                return tmp;
+            }
+
+            Iterator &operator--() {
+                --it;
+                return *this;
+            }
+
+            Iterator operator--(int) {
+                auto tmp = *this;
+                --it;
+                return tmp;
+            }
+
+            bool operator==(const Iterator &other) const {
+                return it == other.it;
+            }
+
+            bool operator!=(const Iterator &other) const {
+                return it != other.it;
+            }
+
+        private:
+            BaseIt it;
+        };
+
+    public:
+        using iterator = Iterator<typename ForwardMap::const_iterator, false>;
+        using inverse_iterator = Iterator<typename InverseMap::const_iterator, true>;
+
+        /**
+         * @brief Inverse lookup of a synced lazy_bidirectional_map. Valid until the map is modified
+         */
+        class inverse_view {
+        public:
+            explicit inverse_view(const lazy_bidirectional_map &map) noexcept: map(&map) {}
+
+            inverse_iterator begin() const {
+                return inverse_iterator(map->inverseMap.begin());
+            }
+
+            inverse_iterator end() const {
+                return inverse_iterator(map->inverseMap.end());
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept {
+                return map->inverseMap.size();
+            }
+
+            [[nodiscard]] bool empty() const noexcept {
+                return map->inverseMap.empty();
+            }
+
+            /**
+             * @copydoc lazy_bidirectional_map::find
+             */
+            inverse_iterator find(const InverseKey &key) const {
+                return inverse_iterator(map->inverseMap.find(key));
+            }
+
+            /**
+             * @copydoc lazy_bidirectional_map::contains
+             */
+            bool contains(const InverseKey &key) const {
+                return find(key) != end();
+            }
+
+            /**
+             * @copydoc lazy_bidirectional_map::at
+             */
+            const ForwardKey &at(const InverseKey &key) const {
+                auto res = find(key);
+                if (res == end()) {
+                    throw std::out_of_range("lazy bidirectional map key not found");
+                }
+
+                return res->second;
+            }
+
+            /**
+             * Access to forward lookup
+             */
+            const lazy_bidirectional_map &inverse() const noexcept {
+                return *map;
+            }
+
+        private:
+            const lazy_bidirectional_map *map;
+        };
+
+        lazy_bidirectional_map() = default;
+
+        /**
+         * Copy constructor. Pending pairs stay pending
+         * @param other source
+         */
+        lazy_bidirectional_map(const lazy_bidirectional_map &other)
+                : forwardMap(other.forwardMap), pending(other.pending.size()), numPending(other.numPending) {
+            if constexpr (impl::traits::has_reserve<InverseMap>::value) {
+                inverseMap.reserve(other.inverseMap.size());
+            }
+
+            for (auto &node : forwardMap) {
+                if (node.second.pendingPos == Synced) {
+                    inverseMap.emplace(node.second.value, &node.first);
+                } else {
+                    pending[node.second.pendingPos] = &node;
+                }
+            }
+        }
+
+        lazy_bidirectional_map(lazy_bidirectional_map &&) noexcept = default;
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to *this
+         */
+        lazy_bidirectional_map &operator=(const lazy_bidirectional_map &other) {
+            if (this != &other) {
+                *this = lazy_bidirectional_map(other);
+            }
+
+            return *this;
+        }
+
+        lazy_bidirectional_map &operator=(lazy_bidirectional_map &&) noexcept = default;
+
+        iterator begin() const {
+            return iterator(forwardMap.begin());
+        }
+
+        iterator end() const {
+            return iterator(forwardMap.end());
+        }
+
+        /**
+         * Number of contained pairs including pending pairs
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return forwardMap.size();
+        }
+
+        /**
+         * Whether the map is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return forwardMap.empty();
+        }
+
+        /**
+         * Whether the inverse lookup is up to date
+         */
+        [[nodiscard]] bool synced() const noexcept {
+            return numPending == 0;
+        }
+
+        /**
+         * Inserts a pair if the forward key is not already contained. Uniqueness of the inverse key is only checked
+         * by the next sync
+         * @param forwardKey forward key
+         * @param inverseKey inverse key
+         * @return std::pair(iterator to inserted element or already existing element, bool whether insertion happened)
+         */
+        template<typename K1, typename K2>
+        auto emplace(K1 &&forwardKey, K2 &&inverseKey) -> std::pair<iterator, bool> {
+            auto [it, inserted] = forwardMap.try_emplace(std::forward<K1>(forwardKey), std::forward<K2>(inverseKey));
+            if (inserted) {
+                it->second.pendingPos = pending.size();
+                try {
+                    pending.emplace_back(&*it);
+                } catch (...) {
+                    forwardMap.erase(it);
+                    throw;
+                }
+
+                ++numPending;
+            }
+
+            return {iterator(it), inserted};
+        }
+
+        /**
+         * Finds the pair with the given forward key
+         * @param key key used for lookup
+         * @return iterator to the found pair or end() if key cannot be found
+         */
+        iterator find(const ForwardKey &key) const {
+            return iterator(forwardMap.find(key));
+        }
+
+        /**
+         * Check if a certain key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        bool contains(const ForwardKey &key) const {
+            return find(key) != end();
+        }
+
+        /**
+         * Returns the value found by the given key
+         * @param key key used for lookup
+         * @return reference to found value
+         * @throws std::out_of_range if key does not exist
+         */
+        const InverseKey &at(const ForwardKey &key) const {
+            auto res = find(key);
+            if (res == end()) {
+                throw std::out_of_range("lazy bidirectional map key not found");
+            }
+
+            return res->second;
+        }
+
+        /**
+         * Erases the pair with the given forward key. Pending pairs leave a tombstone in the pending list, which keeps
+         * the remaining pending pairs in insertion order. Amortized O(1)
+         * @param key key of the pair to erase
+         * @return number of erased pairs (0 or 1)
+         */
+        std::size_t erase(const ForwardKey &key) {
+            auto it = forwardMap.find(key);
+            if (it == forwardMap.end()) {
+                return 0;
+            }
+
+            if (it->second.pendingPos == Synced) {
+                inverseMap.erase(it->second.value);
+            } else {
+                removePending(it->second.pendingPos);
+            }
+
+            forwardMap.erase(it);
+            return 1;
+        }
+
+        /**
+         * Erases all pairs
+         */
+        void clear() noexcept {
+            pending.clear();
+            numPending = 0;
+            inverseMap.clear();
+            forwardMap.clear();
+        }
+
+        /**
+         * Inserts all pending pairs into the inverse lookup. Pending pairs whose inverse key is already contained
+         * are removed from the map. If an exception is thrown, the pairs processed so far stay synced or removed
+         * (the removed pairs are lost) and the remaining pairs stay pending
+         * @return pairs that were removed because their inverse key was not unique, in insertion order
+         */
+        std::vector<std::pair<ForwardKey, InverseKey>> sync() {
+            std::vector<std::pair<ForwardKey, InverseKey>> rejected;
+            if constexpr (impl::traits::has_reserve<InverseMap>::value) {
+                inverseMap.reserve(inverseMap.size() + numPending);
+            }
+
+            std::size_t done = 0;
+            try {
+                while (done < pending.size()) {
+                    auto node = pending[done];
+                    if (node == nullptr) {
+                        ++done;
+                    } else if (inverseMap.emplace(node->second.value, &node->first).second) {
+                        node->second.pendingPos = Synced;
+                        ++done;
+                    } else {
+                        auto handle = forwardMap.extract(node->first);
+                        // the node is gone from the forward map even if storing the rejected pair fails
+                        ++done;
+                        rejected.emplace_back(std::move(handle.key()), std::move(handle.mapped().value));
+                    }
+                }
+            } catch (...) {
+                // processed nodes are synced or already destroyed
+                compactPending(done);
+                throw;
+            }
+
+            pending.clear();
+            numPending = 0;
+            return rejected;
+        }
+
+        /**
+         * Access to inverse lookup. Calls sync first, pairs rejected by sync are discarded
+         * @return view for lookup from inverse keys to forward keys
+         */
+        inverse_view inverse() {
+            sync();
+            return inverse_view(*this);
+        }
+
+        /**
+         * Access to inverse lookup of a synced map
+         * @return view for lookup from inverse keys to forward keys
+         * @throws std::logic_error if there are pending pairs. Call sync first
+         */
+        inverse_view inverse() const {
+            if (!synced()) {
+                throw std::logic_error("lazy bidirectional map is not synced");
+            }
+
+            return inverse_view(*this);
+        }
+
+    private:
+        void removePending(std::size_t pos) noexcept {
+            pending[pos] = nullptr;
+            --numPending;
+            if (pending.size() > MinPending && pending.size() > 2 * numPending) {
+                compactPending(0);
+            }
+        }
+
+        /**
+         * Drops the first `from` entries and all tombstones from the pending list, keeping the order of the rest
+         */
+        void compactPending(std::size_t from) noexcept {
+            std::size_t target = 0;
+            for (auto index = from; index < pending.size(); ++index) {
+                if (auto node = pending[index]; node != nullptr) {
+                    node->second.pendingPos = target;
+                    pending[target++] = node;
+                }
+            }
+
+            pending.resize(target);
+            numPending = target;
+        }
+
+        ForwardMap forwardMap;
+        InverseMap inverseMap;
+        // pending nodes in insertion order, erased pending nodes are nullptr
+        std::vector<Node *> pending;
+        std::size_t numPending = 0;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_LAZY_BIDIRECTIONAL_MAP_HPP
@@ -0,0 +1,598 @@
+/**
+ * @file order_statistics_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains an ordered associative container with order statistics support. It can be used as base
+ * container for bimap::bidirectional_map in order to answer rank, select and range count queries in logarithmic time.
+ */
+
+#ifndef BIDIRECTIONALMAP_ORDER_STATISTICS_MAP_HPP
+#define BIDIRECTIONALMAP_ORDER_STATISTICS_MAP_HPP
+
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+
+namespace bimap {
+    /**
+     * @brief Ordered associative container similar to std::map that additionally supports order statistics queries.
+     * @details The container is implemented as a randomized binary search tree (treap) where every node is augmented
+     * with the size of its subtree. This allows to compute the rank of a key, to select the k-th smallest element and
+     * to count the elements within a key range in O(log n) expected time. All other operations have the same
+     * complexity as for std::map. Elements are node based, i.e. references and iterators are only invalidated when
+     * the corresponding element is erased.
+     * This container can be used as ForwardMapType and / or InverseMapType of bidirectional_map:
+     * ```
+     * bimap::bidirectional_map<std::string, int, bimap::order_statistics_map, bimap::order_statistics_map> map;
+     * map.rank("abc");
+     * map.inverse().select(3);
+     * ```
+     * @tparam Key key type
+     * @tparam T mapped type
+     * @tparam Compare comparator used to order the keys
+     */
+    template<typename Key, typename T, typename Compare = std::less<Key>>
+    class order_statistics_map {
+        struct NodeBase {
+            NodeBase *parent = nullptr;
+            NodeBase *left = nullptr;
+            NodeBase *right = nullptr;
+            std::size_t size = 0;
+            std::uint64_t priority = 0;
+        };
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const Key, T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+
+    private:
+        struct Node : NodeBase {
+            template<typename ...ARGS>
+            explicit Node(ARGS &&...args) : value(std::forward<ARGS>(args)...) {}
+
+            value_type value;
+        };
+
+        static constexpr std::size_t sizeOf(const NodeBase *node) noexcept {
+            return node == nullptr ? 0 : node->size;
+        }
+
+        static constexpr const Key &keyOf(const NodeBase *node) noexcept {
+            return static_cast<const Node *>(node)->value.first;
+        }
+
+        static constexpr NodeBase *leftmost(NodeBase *node) noexcept {
+            while (node->left != nullptr) {
+                node = node->left;
+            }
+
+            return node;
+        }
+
+        static constexpr NodeBase *rightmost(NodeBase *node) noexcept {
+            while (node->right != nullptr) {
+                node = node->right;
+            }
+
+            return node;
+        }
+
+        static constexpr NodeBase *next(NodeBase *node) noexcept {
+            if (node->right != nullptr) {
+                return leftmost(node->right);
+            }
+
+            NodeBase *parent = node->parent;
+            while (node == parent->right) {
+                node = parent;
+                parent = node->parent;
+            }
+
+            return parent;
+        }
+
+        static constexpr NodeBase *prev(NodeBase *node) noexcept {
+            // the header is the only node without parent, its left child is the root
+            if (node->parent == nullptr) {
+                return rightmost(node->left);
+            }
+
+            if (node->left != nullptr) {
+                return rightmost(node->left);
+            }
+
+            NodeBase *parent = node->parent;
+            while (node == parent->left) {
+                node = parent;
+                parent = node->parent;
+            }
+
+            return parent;
+        }
+
+        template<bool Const>
+        class Iterator {
+            friend class order_statistics_map;
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = typename order_statistics_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const value_type &, value_type &>;
+            using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+
+            constexpr Iterator() noexcept = default;
+
+            /**
+             * Conversion from mutable to const iterator
+             * @param other source
+             */
+            template<bool C = Const, typename = std::enable_if_t<C>>
+            constexpr Iterator(const Iterator<false> &other) noexcept: node(other.node) {}
+
+            constexpr Iterator &operator++() noexcept {
+                node = next(node);
+                return *this;
+            }
+
+            constexpr Iterator operator++(int) noexcept {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            constexpr Iterator &operator--() noexcept {
+                node = prev(node);
+                return *this;
+            }
+
+            constexpr Iterator operator--(int) noexcept {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            constexpr reference operator*() const noexcept {
+                return static_cast<Node *>(node)->value;
+            }
+
+            constexpr pointer operator->() const noexcept {
+                return &**this;
+            }
+
+            constexpr bool operator==(const Iterator &other) const noexcept {
+                return node == other.node;
+            }
+
+            constexpr bool operator!=(const Iterator &other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            constexpr explicit Iterator(NodeBase *node) noexcept: node(node) {}
+
+            NodeBase *node = nullptr;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        /**
+         * Creates an empty container
+         * @param comp comparator instance
+         */
+        explicit order_statistics_map(const Compare &comp = Compare()) : comp(comp) {}
+
+        /**
+         * Copy constructor. Copies the tree structure of other
+         * @param other source
+         */
+        order_statistics_map(const order_statistics_map &other) : comp(other.comp), seed(other.seed) {
+            setRoot(clone(other.root(), &header));
+        }
+
+        /**
+         * Move constructor
+         * @param other source, empty afterwards
+         */
+        order_statistics_map(order_statistics_map &&other) noexcept : comp(other.comp) {
+            swap(other);
+        }
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to this
+         */
+        order_statistics_map &operator=(order_statistics_map other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~order_statistics_map() {
+            clear();
+        }
+
+        /**
+         * Swaps the contents of the containers. No elements are copied or moved
+         * @param other swap target
+         */
+        void swap(order_statistics_map &other) noexcept {
+            auto *myRoot = root();
+            setRoot(other.root());
+            other.setRoot(myRoot);
+            std::swap(comp, other.comp);
+            std::swap(seed, other.seed);
+        }
+
+        iterator begin() noexcept {
+            return iterator(empty() ? &header : leftmost(root()));
+        }
+
+        const_iterator begin() const noexcept {
+            return const_iterator(empty() ? headerNode() : leftmost(root()));
+        }
+
+        iterator end() noexcept {
+            return iterator(&header);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(headerNode());
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return sizeOf(root());
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return root() == nullptr;
+        }
+
+        /**
+         * Erases all elements from the container
+         */
+        void clear() noexcept {
+            destroy(root());
+            setRoot(nullptr);
+        }
+
+        /**
+         * Constructs an element in place if no element with equivalent key exists
+         * @tparam ARGS argument types
+         * @param args arguments forwarded to the constructor of value_type
+         * @return std::pair(iterator to inserted or already existing element, bool whether insertion happened)
+         */
+        template<typename ...ARGS>
+        auto emplace(ARGS &&...args) -> std::pair<iterator, bool> {
+            auto *node = new Node(std::forward<ARGS>(args)...);
+            NodeBase *parent = &header;
+            NodeBase **slot = &header.left;
+            while (*slot != nullptr) {
+                parent = *slot;
+                if (comp(node->value.first, keyOf(parent))) {
+                    slot = &parent->left;
+                } else if (comp(keyOf(parent), node->value.first)) {
+                    slot = &parent->right;
+                } else {
+                    delete node;
+                    return {iterator(parent), false};
+                }
+            }
+
+            *slot = node;
+            node->parent = parent;
+            node->size = 1;
+            node->priority = nextPriority();
+            for (auto *curr = parent; curr != &header; curr = curr->parent) {
+                ++curr->size;
+            }
+
+            while (node->parent != &header && node->priority < node->parent->priority) {
+                if (node == node->parent->left) {
+                    rotateRight(node->parent);
+                } else {
+                    rotateLeft(node->parent);
+                }
+            }
+
+            return {iterator(node), true};
+        }
+
+        /**
+         * Erases the element at position pos
+         * @param pos valid dereferenceable iterator
+         * @return iterator following the removed element
+         */
+        iterator erase(const_iterator pos) noexcept {
+            NodeBase *node = pos.node;
+            iterator ret(next(node));
+            while (node->left != nullptr && node->right != nullptr) {
+                if (node->left->priority < node->right->priority) {
+                    rotateRight(node);
+                } else {
+                    rotateLeft(node);
+                }
+            }
+
+            NodeBase *child = node->left != nullptr ? node->left : node->right;
+            replaceChild(node->parent, node, child);
+            if (child != nullptr) {
+                child->parent = node->parent;
+            }
+
+            for (auto *curr = node->parent; curr != &header; curr = curr->parent) {
+                --curr->size;
+            }
+
+            delete static_cast<Node *>(node);
+            return ret;
+        }
+
+        /**
+         * Erases the element with key equivalent to key if it exists
+         * @param key key used for lookup
+         * @return number of erased elements
+         */
+        size_type erase(const Key &key) {
+            auto it = find(key);
+            if (it == end()) {
+                return 0;
+            }
+
+            erase(it);
+            return 1;
+        }
+
+        iterator find(const Key &key) {
+            auto it = lower_bound(key);
+            return it == end() || comp(key, it->first) ? end() : it;
+        }
+
+        const_iterator find(const Key &key) const {
+            return const_cast<order_statistics_map *>(this)->find(key);
+        }
+
+        size_type count(const Key &key) const {
+            return find(key) == end() ? 0 : 1;
+        }
+
+        iterator lower_bound(const Key &key) {
+            return iterator(bound(key, [this](const Key &nodeKey, const Key &k) { return comp(nodeKey, k); }));
+        }
+
+        const_iterator lower_bound(const Key &key) const {
+            return const_cast<order_statistics_map *>(this)->lower_bound(key);
+        }
+
+        iterator upper_bound(const Key &key) {
+            return iterator(bound(key, [this](const Key &nodeKey, const Key &k) { return !comp(k, nodeKey); }));
+        }
+
+        const_iterator upper_bound(const Key &key) const {
+            return const_cast<order_statistics_map *>(this)->upper_bound(key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key) {
+            return {lower_bound(key), upper_bound(key)};
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+            return {lower_bound(key), upper_bound(key)};
+        }
+
+        /**
+         * Number of elements with a key less than key
+         * @param key key used for lookup. Does not have to be contained in the container
+         * @return number of elements that are ordered before key
+         * @note complexity O(log n) expected
+         */
+        size_type rank(const Key &key) const {
+            size_type ret = 0;
+            const NodeBase *node = root();
+            while (node != nullptr) {
+                if (comp(keyOf(node), key)) {
+                    ret += sizeOf(node->left) + 1;
+                    node = node->right;
+                } else {
+                    node = node->left;
+                }
+            }
+
+            return ret;
+        }
+
+        /**
+         * Selects the k-th smallest element (zero based)
+         * @param k index of the element in sorted order
+         * @return iterator to the k-th smallest element or end() if k >= size()
+         * @note complexity O(log n) expected
+         */
+        iterator select(size_type k) noexcept {
+            NodeBase *node = root();
+            while (node != nullptr) {
+                auto leftSize = sizeOf(node->left);
+                if (k < leftSize) {
+                    node = node->left;
+                } else if (k == leftSize) {
+                    return iterator(node);
+                } else {
+                    k -= leftSize + 1;
+                    node = node->right;
+                }
+            }
+
+            return end();
+        }
+
+        /**
+         * @copydoc select
+         */
+        const_iterator select(size_type k) const noexcept {
+            return const_cast<order_statistics_map *>(this)->select(k);
+        }
+
+        /**
+         * Number of elements with keys in the half open range [lo, hi)
+         * @param lo lower bound (inclusive)
+         * @param hi upper bound (exclusive)
+         * @return number of elements in range, 0 if hi is not greater than lo
+         * @note complexity O(log n) expected
+         */
+        size_type count_range(const Key &lo, const Key &hi) const {
+            auto loRank = rank(lo);
+            auto hiRank = rank(hi);
+            return hiRank > loRank ? hiRank - loRank : 0;
+        }
+
+        key_compare key_comp() const {
+            return comp;
+        }
+
+        /**
+         * Element wise comparison
+         * @param other right hand side
+         * @return true if both containers contain equal elements
+         */
+        bool operator==(const order_statistics_map &other) const {
+            return size() == other.size() && std::equal(begin(), end(), other.begin());
+        }
+
+        bool operator!=(const order_statistics_map &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        NodeBase *root() const noexcept {
+            return header.left;
+        }
+
+        NodeBase *headerNode() const noexcept {
+            return const_cast<NodeBase *>(&this->header);
+        }
+
+        void setRoot(NodeBase *node) noexcept {
+            header.left = node;
+            if (node != nullptr) {
+                node->parent = &header;
+            }
+        }
+
+        template<typename GoRight>
+        NodeBase *bound(const Key &key, GoRight goRight) noexcept {
+            NodeBase *ret = &header;
+            NodeBase *node = root();
+            while (node != nullptr) {
+                if (goRight(keyOf(node), key)) {
+                    node = node->right;
+                } else {
+                    ret = node;
+                    node = node->left;
+                }
+            }
+
+            return ret;
+        }
+
+        std::uint64_t nextPriority() noexcept {
+            // xorshift64*
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            return seed * 0x2545F4914F6CDD1DULL;
+        }
+
+        static void replaceChild(NodeBase *parent, NodeBase *oldChild, NodeBase *newChild) noexcept {
+            if (parent->left == oldChild) {
+                parent->left = newChild;
+            } else {
+                parent->right = newChild;
+            }
+        }
+
+        static void updateSize(NodeBase *node) noexcept {
+            node->size = sizeOf(node->left) + sizeOf(node->right) + 1;
+        }
+
+        static void rotateLeft(NodeBase *node) noexcept {
+            NodeBase *pivot = node->right;
+            node->right = pivot->left;
+            if (pivot->left != nullptr) {
+                pivot->left->parent = node;
+            }
+
+            pivot->parent = node->parent;
+            replaceChild(node->parent, node, pivot);
+            pivot->left = node;
+            node->parent = pivot;
+            pivot->size = node->size;
+            updateSize(node);
+        }
+
+        static void rotateRight(NodeBase *node) noexcept {
+            NodeBase *pivot = node->left;
+            node->left = pivot->right;
+            if (pivot->right != nullptr) {
+                pivot->right->parent = node;
+            }
+
+            pivot->parent = node->parent;
+            replaceChild(node->parent, node, pivot);
+            pivot->right = node;
+            node->parent = pivot;
+            pivot->size = node->size;
+            updateSize(node);
+        }
+
+        static NodeBase *clone(const NodeBase *node, NodeBase *parent) {
+            if (node == nullptr) {
+                return nullptr;
+            }
+
+            auto *copy = new Node(static_cast<const Node *>(node)->value);
+            copy->parent = parent;
+            copy->size = node->size;
+            copy->priority = node->priority;
+            try {
+                copy->left = clone(node->left, copy);
+                copy->right = clone(node->right, copy);
+            } catch (...) {
+                destroy(copy);
+                throw;
+            }
+
+            return copy;
+        }
+
+        static void destroy(NodeBase *node) noexcept {
+            while (node != nullptr) {
+                destroy(node->right);
+                auto *left = node->left;
+                delete static_cast<Node *>(node);
+                node = left;
+            }
+        }
+
+        NodeBase header;
+        Compare comp;
+        std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    };
+
+    /**
+     * See member function order_statistics_map::swap
+     * @param lhs left hand side
+     * @param rhs right hand side
+     */
+    template<typename Key, typename T, typename Compare>
+    void swap(order_statistics_map<Key, T, Compare> &lhs, order_statistics_map<Key, T, Compare> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_ORDER_STATISTICS_MAP_HPP
@@ -0,0 +1,89 @@
+/**
+ * @file parallel.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains helpers used to distribute work over multiple threads. Normally there is no need to use
+ * any of its members directly
+ */
+
+#ifndef BIDIRECTIONALMAP_PARALLEL_HPP
+#define BIDIRECTIONALMAP_PARALLEL_HPP
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <exception>
+#include <algorithm>
+
+namespace bimap::impl {
+    /**
+     * Number of threads used by parallel operations if not specified otherwise
+     * @return number of hardware threads, at least 1
+     */
+    inline std::size_t default_concurrency() noexcept {
+        auto ret = std::thread::hardware_concurrency();
+        return ret == 0 ? 1 : ret;
+    }
+
+    /**
+     * Calls fn(i) for every i in [0, numTasks) using up to numThreads threads (including the calling thread). Tasks
+     * are handed out dynamically such that threads that finish early take over remaining tasks
+     * @tparam Fn function type
+     * @param numTasks number of tasks
+     * @param fn function that is called with the task index. Must be safe to be called concurrently
+     * @param numThreads maximum number of threads
+     * @throws the first exception thrown by fn. Remaining tasks are not started in that case
+     */
+    template<typename Fn>
+    void parallel_for(std::size_t numTasks, Fn &&fn, std::size_t numThreads = default_concurrency()) {
+        numThreads = std::min(numThreads, numTasks);
+        if (numThreads <= 1) {
+            for (std::size_t i = 0; i < numTasks; ++i) {
+                fn(i);
+            }
+
+            return;
+        }
+
+        std::atomic<std::size_t> nextTask{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto worker = [&]() {
+            try {
+                for (auto i = nextTask++; i < numTasks && !failed; i = nextTask++) {
+                    fn(i);
+                }
+            } catch (...) {
+                std::lock_guard lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+
+                failed = true;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        try {
+            threads.reserve(numThreads - 1);
+            for (std::size_t i = 1; i < numThreads; ++i) {
+                threads.emplace_back(worker);
+            }
+        } catch (...) {
+            // not being able to spawn threads is not fatal, the remaining threads take over
+        }
+
+        worker();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif //BIDIRECTIONALMAP_PARALLEL_HPP
@@ -0,0 +1,480 @@
+/**
+ * @file partitioned_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains an ordered associative container that partitions its key space into independent ranges.
+ * It can be used as base container for bimap::bidirectional_map in order to scan key ranges in parallel.
+ */
+
+#ifndef BIDIRECTIONALMAP_PARTITIONED_MAP_HPP
+#define BIDIRECTIONALMAP_PARTITIONED_MAP_HPP
+
+#include <map>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "parallel.hpp"
+
+namespace bimap {
+    /**
+     * @brief Ordered associative container similar to std::map whose key space is partitioned into consecutive ranges.
+     * @details Every partition is an independent balanced search tree (std::map). Partitions are split in half when
+     * they grow beyond 2 * partition_size elements. Erasing never moves elements, partitions that became small are
+     * merged with their neighbours during the next emplace. Elements are moved between partitions without copying or
+     * reallocation, references to elements therefore stay valid until the element is erased. Iterators however may be
+     * invalidated by emplace, similar to std::unordered_map on rehash. erase only invalidates iterators to the erased
+     * element. Range scans can be distributed over multiple threads with one task per
+     * partition. When used as base container of bidirectional_map, parallel scans are available for the respective
+     * lookup direction:
+     * ```
+     * bimap::bidirectional_map<int, std::string, bimap::partitioned_map, bimap::partitioned_map> map;
+     * map.parallel_range_for_each(0, 1000, [](int key, const std::string &value) {...});
+     * map.inverse().parallel_range_for_each("a", "b", [](const std::string &key, int value) {...});
+     * ```
+     * @tparam Key key type
+     * @tparam T mapped type
+     * @tparam Compare comparator used to order the keys
+     */
+    template<typename Key, typename T, typename Compare = std::less<Key>>
+    class partitioned_map {
+        using Partition = std::map<Key, T, Compare>;
+        using Partitions = std::vector<std::unique_ptr<Partition>>;
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = typename Partition::value_type;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using key_compare = Compare;
+
+        /**
+         * Target number of elements per partition
+         */
+        static constexpr std::size_t partition_size = 1024;
+
+    private:
+        template<bool Const>
+        class Iterator {
+            friend class partitioned_map;
+            using InnerIterator = std::conditional_t<Const, typename Partition::const_iterator,
+                                                     typename Partition::iterator>;
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = typename partitioned_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const value_type &, value_type &>;
+            using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+
+            Iterator() noexcept = default;
+
+            /**
+             * Conversion from mutable to const iterator
+             * @param other source
+             */
+            template<bool C = Const, typename = std::enable_if_t<C>>
+            Iterator(const Iterator<false> &other) noexcept: owner(other.owner), part(other.part), it(other.it) {}
+
+            Iterator &operator++() {
+                auto curr = it++;
+                if (it == part->end()) {
+                    auto index = owner->partitionOf(curr->first) + 1;
+                    if (index < owner->parts.size()) {
+                        part = owner->parts[index].get();
+                        it = part->begin();
+                    } else {
+                        part = nullptr;
+                    }
+                }
+
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            Iterator &operator--() {
+                if (part == nullptr) {
+                    part = owner->parts.back().get();
+                    it = part->end();
+                } else if (it == part->begin()) {
+                    part = owner->parts[owner->partitionOf(it->first) - 1].get();
+                    it = part->end();
+                }
+
+                --it;
+                return *this;
+            }
+
+            Iterator operator--(int) {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            reference operator*() const noexcept {
+                return *it;
+            }
+
+            pointer operator->() const noexcept {
+                return &*it;
+            }
+
+            bool operator==(const Iterator &other) const noexcept {
+                return part == other.part && (part == nullptr || it == other.it);
+            }
+
+            bool operator!=(const Iterator &other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            Iterator(const partitioned_map *owner, Partition *part, InnerIterator it) noexcept:
+                    owner(owner), part(part), it(it) {}
+
+            const partitioned_map *owner = nullptr;
+            // nullptr for the past-the-end iterator
+            Partition *part = nullptr;
+            InnerIterator it{};
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        /**
+         * Creates an empty container
+         * @param comp comparator instance
+         */
+        explicit partitioned_map(const Compare &comp = Compare()) {
+            parts.emplace_back(std::make_unique<Partition>(comp));
+        }
+
+        /**
+         * Copy constructor
+         * @param other source
+         */
+        partitioned_map(const partitioned_map &other) : numElements(other.numElements) {
+            parts.reserve(other.parts.size());
+            for (const auto &part : other.parts) {
+                parts.emplace_back(std::make_unique<Partition>(*part));
+            }
+        }
+
+        /**
+         * Move constructor
+         * @param other source, empty afterwards
+         * @note this move CTor may throw exceptions if memory allocation fails
+         */
+        partitioned_map(partitioned_map &&other) : partitioned_map(other.key_comp()) {
+            swap(other);
+        }
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to this
+         */
+        partitioned_map &operator=(partitioned_map other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~partitioned_map() = default;
+
+        /**
+         * Swaps the contents of the containers. No elements are copied or moved
+         * @param other swap target
+         */
+        void swap(partitioned_map &other) noexcept {
+            std::swap(parts, other.parts);
+            std::swap(numElements, other.numElements);
+        }
+
+        iterator begin() noexcept {
+            return empty() ? end() : iterator(this, parts.front().get(), parts.front()->begin());
+        }
+
+        const_iterator begin() const noexcept {
+            return const_cast<partitioned_map *>(this)->begin();
+        }
+
+        iterator end() noexcept {
+            return iterator(this, nullptr, {});
+        }
+
+        const_iterator end() const noexcept {
+            return const_cast<partitioned_map *>(this)->end();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return numElements;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return numElements == 0;
+        }
+
+        /**
+         * Number of partitions the key space is currently divided into
+         * @return number of partitions, at least 1
+         */
+        [[nodiscard]] std::size_t partition_count() const noexcept {
+            return parts.size();
+        }
+
+        /**
+         * Erases all elements from the container
+         */
+        void clear() noexcept {
+            parts.erase(parts.begin() + 1, parts.end());
+            parts.front()->clear();
+            numElements = 0;
+        }
+
+        /**
+         * Constructs an element in place if no element with equivalent key exists. Partitions are rebalanced if
+         * necessary, which may invalidate iterators. References stay valid
+         * @tparam ARGS argument types
+         * @param args arguments forwarded to the constructor of value_type
+         * @return std::pair(iterator to inserted or already existing element, bool whether insertion happened)
+         */
+        template<typename ...ARGS>
+        auto emplace(ARGS &&...args) -> std::pair<iterator, bool> {
+            // construct the node first to find the partition without copying or moving the key
+            Partition tmp(key_comp());
+            auto node = tmp.extract(tmp.emplace(std::forward<ARGS>(args)...).first);
+            auto index = partitionOf(node.key());
+            auto res = parts[index]->insert(std::move(node));
+            if (!res.inserted) {
+                return {iterator(this, parts[index].get(), res.position), false};
+            }
+
+            ++numElements;
+            // references survive extract and insert during rebalancing, iterators do not
+            const auto &key = res.position->first;
+            bool rebalance = false;
+            if (parts[index]->size() > 2 * partition_size) {
+                split(index);
+                rebalance = true;
+            }
+
+            if (parts.size() > 1 && parts.size() > 4 * numElements / partition_size) {
+                compact();
+                rebalance = true;
+            }
+
+            if (rebalance) {
+                return {find(key), true};
+            }
+
+            return {iterator(this, parts[index].get(), res.position), true};
+        }
+
+        /**
+         * Erases the element at position pos. Only iterators to the erased element are invalidated
+         * @param pos valid dereferenceable iterator
+         * @return iterator following the removed element
+         */
+        iterator erase(const_iterator pos) {
+            auto ret = std::next(iterator(this, pos.part, pos.part->erase(pos.it, pos.it)));
+            pos.part->erase(pos.it);
+            --numElements;
+            if (pos.part->empty() && parts.size() > 1) {
+                parts.erase(std::find_if(parts.begin(), parts.end(),
+                                         [&pos](const auto &part) { return part.get() == pos.part; }));
+            }
+
+            return ret;
+        }
+
+        /**
+         * Erases the element with key equivalent to key if it exists
+         * @param key key used for lookup
+         * @return number of erased elements
+         */
+        size_type erase(const Key &key) {
+            auto it = find(key);
+            if (it == end()) {
+                return 0;
+            }
+
+            erase(it);
+            return 1;
+        }
+
+        iterator find(const Key &key) {
+            auto &part = *parts[partitionOf(key)];
+            auto it = part.find(key);
+            return it == part.end() ? end() : iterator(this, &part, it);
+        }
+
+        const_iterator find(const Key &key) const {
+            return const_cast<partitioned_map *>(this)->find(key);
+        }
+
+        size_type count(const Key &key) const {
+            return find(key) == end() ? 0 : 1;
+        }
+
+        iterator lower_bound(const Key &key) {
+            auto index = partitionOf(key);
+            return makeIterator(index, parts[index]->lower_bound(key));
+        }
+
+        const_iterator lower_bound(const Key &key) const {
+            return const_cast<partitioned_map *>(this)->lower_bound(key);
+        }
+
+        iterator upper_bound(const Key &key) {
+            auto index = partitionOf(key);
+            return makeIterator(index, parts[index]->upper_bound(key));
+        }
+
+        const_iterator upper_bound(const Key &key) const {
+            return const_cast<partitioned_map *>(this)->upper_bound(key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key) {
+            return {lower_bound(key), upper_bound(key)};
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+            return {lower_bound(key), upper_bound(key)};
+        }
+
+        key_compare key_comp() const {
+            return parts.front()->key_comp();
+        }
+
+        /**
+         * Calls fn for every element with key in [lo, hi). Partitions are processed in parallel, elements within a
+         * partition are visited in order
+         * @tparam Fn function type
+         * @param lo lower bound (inclusive)
+         * @param hi upper bound (exclusive)
+         * @param fn function that is called with const value_type &. Must be safe to be called concurrently
+         * @param numThreads maximum number of threads used
+         */
+        template<typename Fn>
+        void parallel_range_for_each(const Key &lo, const Key &hi, Fn &&fn,
+                                     std::size_t numThreads = impl::default_concurrency()) const {
+            if (empty() || !key_comp()(lo, hi)) {
+                return;
+            }
+
+            auto first = partitionOf(lo);
+            auto last = partitionOf(hi);
+            impl::parallel_for(last - first + 1, [&](std::size_t task) {
+                const auto &part = *parts[first + task];
+                auto curr = task == 0 ? part.lower_bound(lo) : part.begin();
+                auto end = first + task == last ? part.lower_bound(hi) : part.end();
+                for (; curr != end; ++curr) {
+                    fn(*curr);
+                }
+            }, numThreads);
+        }
+
+        /**
+         * Calls fn for every element. Partitions are processed in parallel, elements within a partition are visited
+         * in order
+         * @tparam Fn function type
+         * @param fn function that is called with const value_type &. Must be safe to be called concurrently
+         * @param numThreads maximum number of threads used
+         */
+        template<typename Fn>
+        void parallel_for_each(Fn &&fn, std::size_t numThreads = impl::default_concurrency()) const {
+            impl::parallel_for(parts.size(), [&](std::size_t task) {
+                for (const auto &item : *parts[task]) {
+                    fn(item);
+                }
+            }, numThreads);
+        }
+
+        /**
+         * Element wise comparison
+         * @param other right hand side
+         * @return true if both containers contain equal elements
+         */
+        bool operator==(const partitioned_map &other) const {
+            return size() == other.size() && std::equal(begin(), end(), other.begin());
+        }
+
+        bool operator!=(const partitioned_map &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        /**
+         * Index of the partition responsible for key. All partitions except a single remaining one are non-empty
+         */
+        std::size_t partitionOf(const Key &key) const {
+            auto comp = key_comp();
+            auto it = std::upper_bound(parts.begin() + 1, parts.end(), key, [&comp](const Key &k, const auto &part) {
+                return comp(k, part->begin()->first);
+            });
+            return static_cast<std::size_t>(it - parts.begin()) - 1;
+        }
+
+        iterator makeIterator(std::size_t index, typename Partition::iterator it) {
+            if (it != parts[index]->end()) {
+                return iterator(this, parts[index].get(), it);
+            }
+
+            return index + 1 < parts.size() ? iterator(this, parts[index + 1].get(), parts[index + 1]->begin())
+                                            : end();
+        }
+
+        void split(std::size_t index) {
+            auto &source = *parts[index];
+            auto upper = std::make_unique<Partition>(source.key_comp());
+            auto curr = std::next(source.begin(), static_cast<std::ptrdiff_t>(source.size() / 2));
+            while (curr != source.end()) {
+                upper->insert(upper->end(), source.extract(curr++));
+            }
+
+            parts.emplace(parts.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(upper));
+        }
+
+        /**
+         * Merges neighbouring partitions such that every partition except the last one contains at least
+         * partition_size elements
+         */
+        void compact() {
+            std::size_t target = 0;
+            for (std::size_t i = 1; i < parts.size(); ++i) {
+                auto &dest = *parts[target];
+                auto &source = *parts[i];
+                while (!source.empty() && dest.size() < partition_size) {
+                    dest.insert(dest.end(), source.extract(source.begin()));
+                }
+
+                if (!source.empty()) {
+                    std::swap(parts[++target], parts[i]);
+                }
+            }
+
+            parts.erase(parts.begin() + static_cast<std::ptrdiff_t>(target) + 1, parts.end());
+        }
+
+        Partitions parts;
+        std::size_t numElements = 0;
+    };
+
+    /**
+     * See member function partitioned_map::swap
+     * @param lhs left hand side
+     * @param rhs right hand side
+     */
+    template<typename Key, typename T, typename Compare>
+    void swap(partitioned_map<Key, T, Compare> &lhs, partitioned_map<Key, T, Compare> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_PARTITIONED_MAP_HPP
@@ -0,0 +1,404 @@
+/**
+ * @file permutation_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains an array backed bidirectional map for permutations of the integers 0, ..., n - 1.
+ */
+
+#ifndef BIDIRECTIONALMAP_PERMUTATION_MAP_HPP
+#define BIDIRECTIONALMAP_PERMUTATION_MAP_HPP
+
+#include <vector>
+#include <iterator>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+#include <type_traits>
+#include <algorithm>
+#include <limits>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Non owning read only view of a permutation given by two arrays images and preimages with
+     * images[preimages[i]] == i. Provides the lookup and iterator interface of bidirectional_map.
+     * @tparam Int integral type of the permuted elements
+     */
+    template<typename Int>
+    class permutation_view {
+    public:
+        /**
+         * @brief random access iterator over the pairs (i, images[i])
+         */
+        class iterator {
+        public:
+            using value_type = std::pair<Int, Int>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            constexpr iterator() noexcept = default;
+
+            constexpr iterator(const Int *images, std::size_t pos) noexcept: images(images), pos(pos) {}
+
+            constexpr reference operator*() const noexcept {
+                return {static_cast<Int>(pos), images[pos]};
+            }
+
+            constexpr pointer operator->() const noexcept {
+                return {**this};
+            }
+
+            constexpr reference operator[](difference_type n) const noexcept {
+                return *(*this + n);
+            }
+
+            constexpr iterator &operator++() noexcept {
+                ++pos;
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            constexpr iterator &operator--() noexcept {
+                --pos;
+                return *this;
+            }
+
+            constexpr iterator operator--(int) noexcept {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            constexpr iterator &operator+=(difference_type n) noexcept {
+                pos = static_cast<std::size_t>(static_cast<difference_type>(pos) + n);
+                return *this;
+            }
+
+            constexpr iterator &operator-=(difference_type n) noexcept {
+                return *this += -n;
+            }
+
+            friend constexpr iterator operator+(iterator it, difference_type n) noexcept {
+                return it += n;
+            }
+
+            friend constexpr iterator operator+(difference_type n, iterator it) noexcept {
+                return it += n;
+            }
+
+            friend constexpr iterator operator-(iterator it, difference_type n) noexcept {
+                return it -= n;
+            }
+
+            friend constexpr difference_type operator-(const iterator &lhs, const iterator &rhs) noexcept {
+                return static_cast<difference_type>(lhs.pos) - static_cast<difference_type>(rhs.pos);
+            }
+
+            constexpr bool operator==(const iterator &other) const noexcept {
+                return pos == other.pos && images == other.images;
+            }
+
+            constexpr bool operator!=(const iterator &other) const noexcept {
+                return !(*this == other);
+            }
+
+            constexpr bool operator<(const iterator &other) const noexcept {
+                return pos < other.pos;
+            }
+
+            constexpr bool operator>(const iterator &other) const noexcept {
+                return other < *this;
+            }
+
+            constexpr bool operator<=(const iterator &other) const noexcept {
+                return !(other < *this);
+            }
+
+            constexpr bool operator>=(const iterator &other) const noexcept {
+                return !(*this < other);
+            }
+
+        private:
+            const Int *images = nullptr;
+            std::size_t pos = 0;
+        };
+
+        /**
+         * CTor
+         * @param images array of images
+         * @param preimages array of preimages
+         * @param size number of elements in both arrays
+         */
+        constexpr permutation_view(const Int *images, const Int *preimages, std::size_t size) noexcept
+                : images(images), preimages(preimages), numElements(size) {}
+
+        constexpr iterator begin() const noexcept {
+            return {images, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return {images, numElements};
+        }
+
+        /**
+         * Number of elements
+         */
+        [[nodiscard]] constexpr std::size_t size() const noexcept {
+            return numElements;
+        }
+
+        /**
+         * Whether the permutation is empty
+         */
+        [[nodiscard]] constexpr bool empty() const noexcept {
+            return numElements == 0;
+        }
+
+        /**
+         * Finds the pair containing the given element in O(1)
+         * @param key element used for lookup
+         * @return iterator to the pair (key, image) or end() if key is not in [0, size())
+         */
+        constexpr iterator find(Int key) const noexcept {
+            return contains(key) ? iterator(images, static_cast<std::size_t>(key)) : end();
+        }
+
+        /**
+         * Check if a certain element is permuted
+         * @param key element used for lookup
+         * @return true if key is in [0, size())
+         */
+        constexpr bool contains(Int key) const noexcept {
+            if constexpr (std::is_signed_v<Int>) {
+                if (key < 0) {
+                    return false;
+                }
+            }
+
+            return static_cast<std::size_t>(key) < numElements;
+        }
+
+        /**
+         * Returns the image of an element in O(1)
+         * @param key element used for lookup
+         * @return image of key
+         * @throws std::out_of_range if key is not in [0, size())
+         */
+        constexpr Int at(Int key) const {
+            if (!contains(key)) {
+                throw std::out_of_range("permutation key not found");
+            }
+
+            return images[key];
+        }
+
+        /**
+         * Inverse permutation
+         * @return view of the inverse permutation
+         */
+        constexpr permutation_view inverse() const noexcept {
+            return {preimages, images, numElements};
+        }
+
+        /**
+         * Compares element wise
+         * @param other right hand side
+         * @return true if both permutations are equal
+         */
+        bool operator==(const permutation_view &other) const noexcept {
+            return numElements == other.numElements && std::equal(images, images + numElements, other.images);
+        }
+
+        /**
+         * @copydoc operator==
+         * @return true if permutations are not equal
+         */
+        bool operator!=(const permutation_view &other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        const Int *images;
+        const Int *preimages;
+        std::size_t numElements;
+    };
+
+    /**
+     * @brief Bidirectional map for dense integer bijections, i.e. permutations of 0, ..., n - 1.
+     * @details Images and preimages are stored in two arrays, which requires 2 * sizeof(Int) bytes per element.
+     * Lookup in both directions as well as swapping the images of two elements takes O(1). The interface is similar
+     * to the one of bidirectional_map:
+     * ```
+     * bimap::permutation_map<> order(std::vector<std::uint32_t>{2, 0, 1});
+     * order.at(0); // 2
+     * order.inverse().at(0); // 1
+     * for (auto [pos, image] : order) {...}
+     * ```
+     * @tparam Int integral type of the permuted elements
+     */
+    template<typename Int = std::uint32_t>
+    class permutation_map {
+        static_assert(std::is_integral_v<Int>, "permutation_map requires an integral element type");
+    public:
+        using iterator = typename permutation_view<Int>::iterator;
+
+        /**
+         * Creates an empty permutation
+         */
+        permutation_map() = default;
+
+        /**
+         * Creates the identity permutation
+         * @param size number of elements
+         * @throws std::length_error if size - 1 is not representable by Int
+         */
+        explicit permutation_map(std::size_t size) : images(checkedSize(size)), preimages(size) {
+            for (std::size_t i = 0; i < size; ++i) {
+                images[i] = preimages[i] = static_cast<Int>(i);
+            }
+        }
+
+        /**
+         * Creates the permutation i -> images[i]
+         * @param images images of the elements 0, ..., images.size() - 1
+         * @throws std::invalid_argument if images is not a permutation of 0, ..., images.size() - 1
+         * @throws std::length_error if images.size() - 1 is not representable by Int
+         */
+        explicit permutation_map(std::vector<Int> images) : images(std::move(images)) {
+            checkedSize(this->images.size());
+            constexpr Int Unset = std::numeric_limits<Int>::max();
+            preimages.assign(this->images.size(), Unset);
+            for (std::size_t i = 0; i < this->images.size(); ++i) {
+                const auto image = this->images[i];
+                if (!view().contains(image) || preimages[image] != Unset) {
+                    throw std::invalid_argument("images do not form a permutation");
+                }
+
+                preimages[image] = static_cast<Int>(i);
+            }
+        }
+
+        /**
+         * Non owning view of the permutation. Valid as long as the permutation is not destroyed or reassigned
+         */
+        permutation_view<Int> view() const noexcept {
+            return {images.data(), preimages.data(), images.size()};
+        }
+
+        /**
+         * Inverse permutation
+         * @return view of the inverse permutation. Valid as long as the permutation is not destroyed or reassigned
+         */
+        permutation_view<Int> inverse() const noexcept {
+            return view().inverse();
+        }
+
+        iterator begin() const noexcept {
+            return view().begin();
+        }
+
+        iterator end() const noexcept {
+            return view().end();
+        }
+
+        /**
+         * @copydoc permutation_view::size
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return images.size();
+        }
+
+        /**
+         * @copydoc permutation_view::empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return images.empty();
+        }
+
+        /**
+         * @copydoc permutation_view::find
+         */
+        iterator find(Int key) const noexcept {
+            return view().find(key);
+        }
+
+        /**
+         * @copydoc permutation_view::contains
+         */
+        bool contains(Int key) const noexcept {
+            return view().contains(key);
+        }
+
+        /**
+         * @copydoc permutation_view::at
+         */
+        Int at(Int key) const {
+            return view().at(key);
+        }
+
+        /**
+         * Swaps the images of two elements in O(1)
+         * @param lhs first element
+         * @param rhs second element
+         * @throws std::out_of_range if one of the elements is not in [0, size())
+         */
+        void swap_images(Int lhs, Int rhs) {
+            if (!contains(lhs) || !contains(rhs)) {
+                throw std::out_of_range("permutation key not found");
+            }
+
+            std::swap(images[lhs], images[rhs]);
+            preimages[images[lhs]] = lhs;
+            preimages[images[rhs]] = rhs;
+        }
+
+        /**
+         * Swaps the preimages of two elements in O(1), i.e. swap_images on the inverse permutation
+         * @param lhs first element
+         * @param rhs second element
+         * @throws std::out_of_range if one of the elements is not in [0, size())
+         */
+        void swap_preimages(Int lhs, Int rhs) {
+            swap_images(inverse().at(lhs), inverse().at(rhs));
+        }
+
+        /**
+         * Swaps the content of two permutations
+         * @param other swap target
+         */
+        void swap(permutation_map &other) noexcept {
+            std::swap(images, other.images);
+            std::swap(preimages, other.preimages);
+        }
+
+        bool operator==(const permutation_map &other) const noexcept {
+            return images == other.images;
+        }
+
+        bool operator!=(const permutation_map &other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        static std::size_t checkedSize(std::size_t size) {
+            if (size > 0 && size - 1 > static_cast<std::size_t>(std::numeric_limits<Int>::max())) {
+                throw std::length_error("permutation too large for element type");
+            }
+
+            return size;
+        }
+
+        std::vector<Int> images;
+        std::vector<Int> preimages;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_PERMUTATION_MAP_HPP
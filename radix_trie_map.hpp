@@ -0,0 +1,579 @@
+/**
+ * @file radix_trie_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains an ordered associative container for string keys based on a compressed radix trie. It can
+ * be used as base container for bimap::bidirectional_map in order to efficiently search for key prefixes.
+ */
+
+#ifndef BIDIRECTIONALMAP_RADIX_TRIE_MAP_HPP
+#define BIDIRECTIONALMAP_RADIX_TRIE_MAP_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+
+namespace bimap {
+    /**
+     * @brief Ordered associative container for string keys implemented as compressed radix trie (patricia trie).
+     * @details Lookup only compares every character of the key once instead of comparing whole strings at every tree
+     * level like std::map does. Edge labels are not copied, they reference the characters of the keys stored in the
+     * trie, such that every key is stored exactly once and common prefixes only exist once in the trie structure.
+     * Elements are ordered lexicographically, i.e. in the same order as std::map<Key, T> would order them. Iterators
+     * and references are only invalidated when the corresponding element is erased. In addition to the std::map
+     * interface, prefix_range can be used to find all elements whose keys start with a given prefix. When used as
+     * base container of bidirectional_map, prefix search is available for forward lookup:
+     * ```
+     * bimap::bidirectional_map<std::string, int, bimap::radix_trie_map> map;
+     * auto [begin, end] = map.prefix_range("region/service/");
+     * ```
+     * @tparam Key string type, specialization of std::basic_string
+     * @tparam T mapped type
+     */
+    template<typename Key, typename T>
+    class radix_trie_map {
+        using CharT = typename Key::value_type;
+        using Traits = typename Key::traits_type;
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const Key, T>;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+        struct Node {
+            Node *parent = nullptr;
+            // element in the subtree whose key contains the characters of the edge label
+            const value_type *labelOwner = nullptr;
+            // length of the key prefix represented by this node
+            std::size_t depth = 0;
+            std::size_t labelLength = 0;
+            std::vector<std::unique_ptr<Node>> children;
+            std::unique_ptr<value_type> value;
+
+            const CharT *label() const noexcept {
+                return labelOwner->first.data() + (depth - labelLength);
+            }
+
+            CharT front() const noexcept {
+                return *label();
+            }
+        };
+
+        static Node *first(Node *node) noexcept {
+            while (!node->value) {
+                node = node->children.front().get();
+            }
+
+            return node;
+        }
+
+        static Node *last(Node *node) noexcept {
+            while (!node->children.empty()) {
+                node = node->children.back().get();
+            }
+
+            return node->value ? node : nullptr;
+        }
+
+        static std::size_t indexOf(const Node *parent, CharT c) noexcept {
+            auto it = std::lower_bound(parent->children.begin(), parent->children.end(), c,
+                                       [](const auto &child, CharT ch) { return Traits::lt(child->front(), ch); });
+            return static_cast<std::size_t>(it - parent->children.begin());
+        }
+
+        static Node *childAt(const Node *parent, CharT c) noexcept {
+            auto index = indexOf(parent, c);
+            if (index < parent->children.size() && Traits::eq(parent->children[index]->front(), c)) {
+                return parent->children[index].get();
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * First element after the subtree of node in lexicographic order
+         */
+        static Node *nextAfterSubtree(Node *node) noexcept {
+            while (node->parent != nullptr) {
+                auto *parent = node->parent;
+                auto index = indexOf(parent, node->front());
+                if (index + 1 < parent->children.size()) {
+                    return first(parent->children[index + 1].get());
+                }
+
+                node = parent;
+            }
+
+            return nullptr;
+        }
+
+        static Node *next(Node *node) noexcept {
+            if (!node->children.empty()) {
+                return first(node->children.front().get());
+            }
+
+            return nextAfterSubtree(node);
+        }
+
+        static Node *prev(Node *node, Node *root) noexcept {
+            if (node == nullptr) {
+                return last(root);
+            }
+
+            while (node->parent != nullptr) {
+                auto *parent = node->parent;
+                auto index = indexOf(parent, node->front());
+                if (index > 0) {
+                    return last(parent->children[index - 1].get());
+                }
+
+                if (parent->value) {
+                    return parent;
+                }
+
+                node = parent;
+            }
+
+            return nullptr;
+        }
+
+        template<bool Const>
+        class Iterator {
+            friend class radix_trie_map;
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = typename radix_trie_map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const value_type &, value_type &>;
+            using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+
+            constexpr Iterator() noexcept = default;
+
+            /**
+             * Conversion from mutable to const iterator
+             * @param other source
+             */
+            template<bool C = Const, typename = std::enable_if_t<C>>
+            constexpr Iterator(const Iterator<false> &other) noexcept: node(other.node), root(other.root) {}
+
+            Iterator &operator++() noexcept {
+                node = next(node);
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            Iterator &operator--() noexcept {
+                node = prev(node, root);
+                return *this;
+            }
+
+            Iterator operator--(int) noexcept {
+                auto tmp = *this;
+                --*this;
+                return tmp;
+            }
+
+            reference operator*() const noexcept {
+                return *node->value;
+            }
+
+            pointer operator->() const noexcept {
+                return node->value.get();
+            }
+
+            constexpr bool operator==(const Iterator &other) const noexcept {
+                return node == other.node;
+            }
+
+            constexpr bool operator!=(const Iterator &other) const noexcept {
+                return !(*this == other);
+            }
+
+        private:
+            constexpr Iterator(Node *node, Node *root) noexcept: node(node), root(root) {}
+
+            Node *node = nullptr;
+            Node *root = nullptr;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        /**
+         * Creates an empty container
+         */
+        radix_trie_map() : root(std::make_unique<Node>()) {}
+
+        /**
+         * Copy constructor
+         * @param other source
+         */
+        radix_trie_map(const radix_trie_map &other) : radix_trie_map() {
+            for (const auto &value : other) {
+                emplace(value);
+            }
+        }
+
+        /**
+         * Move constructor
+         * @param other source, empty afterwards
+         * @note this move CTor may throw exceptions if memory allocation fails
+         */
+        radix_trie_map(radix_trie_map &&other) : radix_trie_map() {
+            swap(other);
+        }
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to this
+         */
+        radix_trie_map &operator=(radix_trie_map other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~radix_trie_map() = default;
+
+        /**
+         * Swaps the contents of the containers. No elements are copied or moved
+         * @param other swap target
+         */
+        void swap(radix_trie_map &other) noexcept {
+            std::swap(root, other.root);
+            std::swap(numElements, other.numElements);
+        }
+
+        iterator begin() noexcept {
+            return iterator(empty() ? nullptr : first(root.get()), root.get());
+        }
+
+        const_iterator begin() const noexcept {
+            return const_cast<radix_trie_map *>(this)->begin();
+        }
+
+        iterator end() noexcept {
+            return iterator(nullptr, root.get());
+        }
+
+        const_iterator end() const noexcept {
+            return const_cast<radix_trie_map *>(this)->end();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return numElements;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return numElements == 0;
+        }
+
+        /**
+         * Erases all elements from the container
+         */
+        void clear() noexcept {
+            root->children.clear();
+            root->value.reset();
+            numElements = 0;
+        }
+
+        /**
+         * Constructs an element in place if no element with equivalent key exists
+         * @tparam ARGS argument types
+         * @param args arguments forwarded to the constructor of value_type
+         * @return std::pair(iterator to inserted or already existing element, bool whether insertion happened)
+         */
+        template<typename ...ARGS>
+        auto emplace(ARGS &&...args) -> std::pair<iterator, bool> {
+            auto value = std::make_unique<value_type>(std::forward<ARGS>(args)...);
+            const Key &key = value->first;
+            Node *node = root.get();
+            std::size_t pos = 0;
+            while (pos < key.size()) {
+                auto index = indexOf(node, key[pos]);
+                if (index == node->children.size() || !Traits::eq(node->children[index]->front(), key[pos])) {
+                    auto leaf = std::make_unique<Node>();
+                    leaf->parent = node;
+                    leaf->depth = key.size();
+                    leaf->labelLength = key.size() - pos;
+                    leaf->value = std::move(value);
+                    leaf->labelOwner = leaf->value.get();
+                    auto *ret = leaf.get();
+                    node->children.emplace(node->children.begin() + index, std::move(leaf));
+                    ++numElements;
+                    return {iterator(ret, root.get()), true};
+                }
+
+                Node *child = node->children[index].get();
+                auto common = commonPrefix(child, key, pos);
+                if (common < child->labelLength) {
+                    auto split = std::make_unique<Node>();
+                    split->children.reserve(2);
+                    split->parent = node;
+                    split->labelOwner = child->labelOwner;
+                    split->depth = pos + common;
+                    split->labelLength = common;
+                    child->labelLength -= common;
+                    child->parent = split.get();
+                    split->children.emplace_back(std::move(node->children[index]));
+                    node->children[index] = std::move(split);
+                    child = node->children[index].get();
+                }
+
+                pos += common;
+                node = child;
+            }
+
+            if (node->value) {
+                return {iterator(node, root.get()), false};
+            }
+
+            node->value = std::move(value);
+            ++numElements;
+            return {iterator(node, root.get()), true};
+        }
+
+        /**
+         * Erases the element at position pos
+         * @param pos valid dereferenceable iterator
+         * @return iterator following the removed element
+         */
+        iterator erase(const_iterator pos) noexcept {
+            Node *node = pos.node;
+            iterator ret(next(node), root.get());
+            std::unique_ptr<value_type> erased = std::move(node->value);
+            Node *survivor = node;
+            if (node->parent != nullptr) {
+                if (node->children.empty()) {
+                    survivor = node->parent;
+                    detach(node);
+                    if (survivor->parent != nullptr && !survivor->value && survivor->children.size() == 1) {
+                        survivor = mergeWithChild(survivor);
+                    }
+                } else if (node->children.size() == 1) {
+                    survivor = mergeWithChild(node);
+                }
+            }
+
+            // edge labels that reference the erased key are redirected to another key in their subtree
+            for (Node *curr = survivor; curr->parent != nullptr; curr = curr->parent) {
+                if (curr->labelOwner == erased.get()) {
+                    curr->labelOwner = first(curr)->value.get();
+                }
+            }
+
+            --numElements;
+            return ret;
+        }
+
+        /**
+         * Erases the element with key equivalent to key if it exists
+         * @param key key used for lookup
+         * @return number of erased elements
+         */
+        size_type erase(const Key &key) {
+            auto it = find(key);
+            if (it == end()) {
+                return 0;
+            }
+
+            erase(it);
+            return 1;
+        }
+
+        iterator find(const Key &key) noexcept {
+            Node *node = root.get();
+            std::size_t pos = 0;
+            while (pos < key.size()) {
+                node = childAt(node, key[pos]);
+                if (node == nullptr || commonPrefix(node, key, pos) != node->labelLength) {
+                    return end();
+                }
+
+                pos += node->labelLength;
+            }
+
+            return node->value ? iterator(node, root.get()) : end();
+        }
+
+        const_iterator find(const Key &key) const noexcept {
+            return const_cast<radix_trie_map *>(this)->find(key);
+        }
+
+        size_type count(const Key &key) const noexcept {
+            return find(key) == end() ? 0 : 1;
+        }
+
+        iterator lower_bound(const Key &key) noexcept {
+            Node *node = root.get();
+            std::size_t pos = 0;
+            while (pos < key.size()) {
+                auto index = indexOf(node, key[pos]);
+                if (index == node->children.size()) {
+                    return iterator(nextAfterSubtree(node), root.get());
+                }
+
+                Node *child = node->children[index].get();
+                if (!Traits::eq(child->front(), key[pos])) {
+                    return iterator(first(child), root.get());
+                }
+
+                auto common = commonPrefix(child, key, pos);
+                if (common < child->labelLength) {
+                    if (pos + common == key.size() || Traits::lt(key[pos + common], child->label()[common])) {
+                        return iterator(first(child), root.get());
+                    }
+
+                    return iterator(nextAfterSubtree(child), root.get());
+                }
+
+                pos += common;
+                node = child;
+            }
+
+            return iterator(node->value || !node->children.empty() ? first(node) : nextAfterSubtree(node),
+                            root.get());
+        }
+
+        const_iterator lower_bound(const Key &key) const noexcept {
+            return const_cast<radix_trie_map *>(this)->lower_bound(key);
+        }
+
+        iterator upper_bound(const Key &key) noexcept {
+            auto it = lower_bound(key);
+            if (it != end() && it->first == key) {
+                ++it;
+            }
+
+            return it;
+        }
+
+        const_iterator upper_bound(const Key &key) const noexcept {
+            return const_cast<radix_trie_map *>(this)->upper_bound(key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key) noexcept {
+            auto it = find(key);
+            if (it == end()) {
+                auto bound = lower_bound(key);
+                return {bound, bound};
+            }
+
+            return {it, std::next(it)};
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const noexcept {
+            return const_cast<radix_trie_map *>(this)->equal_range(key);
+        }
+
+        /**
+         * Finds all elements whose keys start with prefix
+         * @param prefix key prefix
+         * @return iterator range [first, last) that contains exactly the elements whose keys start with prefix
+         * @note complexity is O(prefix.size()) and does not depend on the number of elements
+         */
+        std::pair<iterator, iterator> prefix_range(const Key &prefix) noexcept {
+            Node *node = root.get();
+            std::size_t pos = 0;
+            while (pos < prefix.size()) {
+                node = childAt(node, prefix[pos]);
+                if (node == nullptr) {
+                    auto bound = lower_bound(prefix);
+                    return {bound, bound};
+                }
+
+                auto common = commonPrefix(node, prefix, pos);
+                if (common < node->labelLength && pos + common < prefix.size()) {
+                    auto bound = lower_bound(prefix);
+                    return {bound, bound};
+                }
+
+                pos += common;
+            }
+
+            if (node->parent == nullptr) {
+                return {begin(), end()};
+            }
+
+            return {iterator(first(node), root.get()), iterator(nextAfterSubtree(node), root.get())};
+        }
+
+        /**
+         * @copydoc prefix_range
+         */
+        std::pair<const_iterator, const_iterator> prefix_range(const Key &prefix) const noexcept {
+            return const_cast<radix_trie_map *>(this)->prefix_range(prefix);
+        }
+
+        /**
+         * Element wise comparison
+         * @param other right hand side
+         * @return true if both containers contain equal elements
+         */
+        bool operator==(const radix_trie_map &other) const {
+            return size() == other.size() && std::equal(begin(), end(), other.begin());
+        }
+
+        bool operator!=(const radix_trie_map &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        static std::size_t commonPrefix(const Node *node, const Key &key, std::size_t pos) noexcept {
+            auto length = std::min(node->labelLength, key.size() - pos);
+            const CharT *label = node->label();
+            std::size_t ret = 0;
+            while (ret < length && Traits::eq(label[ret], key[pos + ret])) {
+                ++ret;
+            }
+
+            return ret;
+        }
+
+        static void detach(Node *node) noexcept {
+            auto &siblings = node->parent->children;
+            siblings.erase(siblings.begin() + static_cast<std::ptrdiff_t>(indexOf(node->parent, node->front())));
+        }
+
+        /**
+         * Merges a node without value that has exactly one child with said child
+         * @return the merged node
+         */
+        static Node *mergeWithChild(Node *node) noexcept {
+            auto *parent = node->parent;
+            auto index = indexOf(parent, node->front());
+            auto child = std::move(node->children.front());
+            child->labelLength += node->labelLength;
+            child->parent = parent;
+            auto *ret = child.get();
+            parent->children[index] = std::move(child);
+            return ret;
+        }
+
+        std::unique_ptr<Node> root;
+        std::size_t numElements = 0;
+    };
+
+    /**
+     * See member function radix_trie_map::swap
+     * @param lhs left hand side
+     * @param rhs right hand side
+     */
+    template<typename Key, typename T>
+    void swap(radix_trie_map<Key, T> &lhs, radix_trie_map<Key, T> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_RADIX_TRIE_MAP_HPP
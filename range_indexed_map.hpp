@@ -0,0 +1,496 @@
+/**
+ * @file range_indexed_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains an ordered associative container that additionally maintains a two dimensional index over
+ * (key, mapped key) pairs. It can be used as base container for bimap::bidirectional_map in order to answer orthogonal
+ * range queries over (K1, K2) pairs.
+ */
+
+#ifndef BIDIRECTIONALMAP_RANGE_INDEXED_MAP_HPP
+#define BIDIRECTIONALMAP_RANGE_INDEXED_MAP_HPP
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+namespace bimap {
+    namespace impl {
+        namespace traits {
+            template<typename T, typename = std::void_t<>>
+            struct is_dereferenceable : std::false_type {};
+
+            template<typename T>
+            struct is_dereferenceable<T, std::void_t<decltype(*std::declval<const T &>())>> : std::true_type {};
+        }
+
+        /**
+         * Helper function that resolves the key stored in a mapped value
+         * @tparam T mapped type
+         * @param value mapped value
+         * @return if T is dereferenceable (like impl::Surrogate), the object behind the pointer. Otherwise value
+         */
+        template<typename T>
+        constexpr decltype(auto) mapped_key(const T &value) noexcept {
+            if constexpr (traits::is_dereferenceable<T>::value) {
+                return *value;
+            } else {
+                return (value);
+            }
+        }
+    }
+
+    /**
+     * @brief Ordered associative container similar to std::map that additionally maintains a two dimensional k-d tree
+     * index over (key, mapped key) pairs.
+     * @details Lookup, iteration and ordering are provided by an underlying std::map, iterators and references are
+     * the ones of std::map. The index is organized as a logarithmic number of static k-d trees
+     * (Bentley-Saxe method). New elements are buffered and merged into the index on the next range query, erased
+     * elements are removed lazily and the next range query rebuilds the index once the number of removed elements
+     * exceeds the number of indexed ones. Erasing therefore never allocates. Orthogonal range queries and counts take O(sqrt(n) + k) time where k is the number of reported
+     * elements. If the mapped type is dereferenceable (like the surrogate pointers used by bidirectional_map), the
+     * second dimension is the object behind the pointer. When used as base container of bidirectional_map, this
+     * enables range queries over (K1, K2) pairs:
+     * ```
+     * bimap::bidirectional_map<int, int, bimap::range_indexed_map> map;
+     * map.range_count(0, 10, 100, 200); // number of pairs with K1 in [0, 10] and K2 in [100, 200]
+     * ```
+     * @tparam Key key type
+     * @tparam T mapped type
+     * @tparam Compare comparator used to order the keys
+     * @tparam MappedCompare comparator used to order mapped keys in the second index dimension
+     * @note Range queries update the index lazily and are therefore not safe to be called concurrently even though
+     * they are const qualified
+     */
+    template<typename Key, typename T, typename Compare = std::less<Key>, typename MappedCompare = std::less<>>
+    class range_indexed_map {
+        using BaseMap = std::map<Key, T, Compare>;
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = typename BaseMap::value_type;
+        using size_type = typename BaseMap::size_type;
+        using key_compare = Compare;
+        using iterator = typename BaseMap::iterator;
+        using const_iterator = typename BaseMap::const_iterator;
+        using mapped_key_type = std::remove_cv_t<std::remove_reference_t<decltype(
+                impl::mapped_key(std::declval<const T &>()))>>;
+
+    private:
+        struct Entry {
+            const value_type *item;
+            bool alive;
+        };
+
+        struct Level {
+            std::vector<Entry> entries;
+            std::size_t numDead = 0;
+        };
+
+        struct Location {
+            Level *level;
+            std::size_t index;
+        };
+
+        struct Query {
+            const Key &lo1;
+            const Key &hi1;
+            const mapped_key_type &lo2;
+            const mapped_key_type &hi2;
+        };
+
+    public:
+        /**
+         * Creates an empty container
+         * @param comp comparator instance
+         * @param mappedComp comparator instance for mapped keys
+         */
+        explicit range_indexed_map(const Compare &comp = Compare(), const MappedCompare &mappedComp = MappedCompare())
+                : map(comp), mappedComp(mappedComp) {}
+
+        /**
+         * Copy constructor. The index of the copy is built lazily on the first range query
+         * @param other source
+         */
+        range_indexed_map(const range_indexed_map &other) : map(other.map), mappedComp(other.mappedComp) {
+            for (const auto &item : map) {
+                addPending(&item);
+            }
+        }
+
+        range_indexed_map(range_indexed_map &&) noexcept = default;
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to this
+         */
+        range_indexed_map &operator=(range_indexed_map other) noexcept {
+            swap(other);
+            return *this;
+        }
+
+        ~range_indexed_map() = default;
+
+        /**
+         * Swaps the contents of the containers. No elements are copied or moved
+         * @param other swap target
+         */
+        void swap(range_indexed_map &other) noexcept {
+            std::swap(map, other.map);
+            std::swap(mappedComp, other.mappedComp);
+            std::swap(levels, other.levels);
+            std::swap(pending, other.pending);
+            std::swap(locations, other.locations);
+            std::swap(numDead, other.numDead);
+        }
+
+        iterator begin() noexcept {
+            return map.begin();
+        }
+
+        const_iterator begin() const noexcept {
+            return map.begin();
+        }
+
+        iterator end() noexcept {
+            return map.end();
+        }
+
+        const_iterator end() const noexcept {
+            return map.end();
+        }
+
+        [[nodiscard]] size_type size() const noexcept {
+            return map.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return map.empty();
+        }
+
+        /**
+         * Erases all elements from the container
+         */
+        void clear() noexcept {
+            map.clear();
+            levels.clear();
+            pending.clear();
+            locations.clear();
+            numDead = 0;
+        }
+
+        /**
+         * Constructs an element in place if no element with equivalent key exists. The element is added to the range
+         * index on the next range query
+         * @tparam ARGS argument types
+         * @param args arguments forwarded to the constructor of value_type
+         * @return std::pair(iterator to inserted or already existing element, bool whether insertion happened)
+         */
+        template<typename ...ARGS>
+        auto emplace(ARGS &&...args) -> std::pair<iterator, bool> {
+            auto res = map.emplace(std::forward<ARGS>(args)...);
+            if (res.second) {
+                try {
+                    addPending(&*res.first);
+                } catch (...) {
+                    map.erase(res.first);
+                    throw;
+                }
+            }
+
+            return res;
+        }
+
+        /**
+         * Erases the element at position pos. Does not allocate, the index is cleaned up by the next range query
+         * @param pos valid dereferenceable iterator
+         * @return iterator following the removed element
+         */
+        iterator erase(const_iterator pos) {
+            removeFromIndex(&*pos);
+            return map.erase(pos);
+        }
+
+        /**
+         * Erases the element with key equivalent to key if it exists
+         * @param key key used for lookup
+         * @return number of erased elements
+         */
+        size_type erase(const Key &key) {
+            auto it = map.find(key);
+            if (it == map.end()) {
+                return 0;
+            }
+
+            erase(it);
+            return 1;
+        }
+
+        iterator find(const Key &key) {
+            return map.find(key);
+        }
+
+        const_iterator find(const Key &key) const {
+            return map.find(key);
+        }
+
+        size_type count(const Key &key) const {
+            return map.count(key);
+        }
+
+        iterator lower_bound(const Key &key) {
+            return map.lower_bound(key);
+        }
+
+        const_iterator lower_bound(const Key &key) const {
+            return map.lower_bound(key);
+        }
+
+        iterator upper_bound(const Key &key) {
+            return map.upper_bound(key);
+        }
+
+        const_iterator upper_bound(const Key &key) const {
+            return map.upper_bound(key);
+        }
+
+        std::pair<iterator, iterator> equal_range(const Key &key) {
+            return map.equal_range(key);
+        }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key &key) const {
+            return map.equal_range(key);
+        }
+
+        key_compare key_comp() const {
+            return map.key_comp();
+        }
+
+        /**
+         * Calls fn for every element with key in [lo1, hi1] and mapped key in [lo2, hi2]. Elements are reported in no
+         * particular order
+         * @tparam Fn function type
+         * @param lo1 lower bound of keys (inclusive)
+         * @param hi1 upper bound of keys (inclusive)
+         * @param lo2 lower bound of mapped keys (inclusive)
+         * @param hi2 upper bound of mapped keys (inclusive)
+         * @param fn function called with const value_type &
+         */
+        template<typename Fn>
+        void range_query(const Key &lo1, const Key &hi1, const mapped_key_type &lo2, const mapped_key_type &hi2,
+                         Fn &&fn) const {
+            flush();
+            Query query{lo1, hi1, lo2, hi2};
+            for (const auto &level : levels) {
+                visit(level->entries, 0, level->entries.size(), 0, query, fn);
+            }
+        }
+
+        /**
+         * Number of elements with key in [lo1, hi1] and mapped key in [lo2, hi2]
+         * @param lo1 lower bound of keys (inclusive)
+         * @param hi1 upper bound of keys (inclusive)
+         * @param lo2 lower bound of mapped keys (inclusive)
+         * @param hi2 upper bound of mapped keys (inclusive)
+         * @return number of elements in the query rectangle
+         */
+        size_type range_count(const Key &lo1, const Key &hi1, const mapped_key_type &lo2,
+                              const mapped_key_type &hi2) const {
+            size_type ret = 0;
+            range_query(lo1, hi1, lo2, hi2, [&ret](const value_type &) { ++ret; });
+            return ret;
+        }
+
+        bool operator==(const range_indexed_map &other) const {
+            return map == other.map;
+        }
+
+        bool operator!=(const range_indexed_map &other) const {
+            return !(*this == other);
+        }
+
+    private:
+        void addPending(const value_type *item) {
+            pending.emplace_back(item);
+            try {
+                locations[item] = Location{nullptr, pending.size() - 1};
+            } catch (...) {
+                pending.pop_back();
+                throw;
+            }
+        }
+
+        /**
+         * Marks the element as removed. Only touches existing entries and never allocates, so erase cannot fail after
+         * the element was removed from the index
+         */
+        void removeFromIndex(const value_type *item) noexcept {
+            auto locIt = locations.find(item);
+            auto [level, index] = locIt->second;
+            if (level == nullptr) {
+                if (index != pending.size() - 1) {
+                    pending[index] = pending.back();
+                    locations.find(pending[index])->second.index = index;
+                }
+
+                pending.pop_back();
+            } else {
+                level->entries[index].alive = false;
+                ++level->numDead;
+                ++numDead;
+            }
+
+            locations.erase(locIt);
+        }
+
+        /**
+         * Moves all indexed elements back to the buffer of new elements
+         */
+        void rebuild() const {
+            std::vector<const value_type *> items;
+            items.reserve(locations.size());
+            items.insert(items.end(), pending.begin(), pending.end());
+            for (const auto &level : levels) {
+                for (const auto &entry : level->entries) {
+                    if (entry.alive) {
+                        items.emplace_back(entry.item);
+                    }
+                }
+            }
+
+            // no allocations from here on, the locations of all elements exist already
+            pending.swap(items);
+            levels.clear();
+            numDead = 0;
+            for (std::size_t i = 0; i < pending.size(); ++i) {
+                locations.find(pending[i])->second = Location{nullptr, i};
+            }
+        }
+
+        void flush() const {
+            if (numDead > locations.size()) {
+                rebuild();
+            }
+
+            if (pending.empty()) {
+                return;
+            }
+
+            auto level = std::make_unique<Level>();
+            auto &entries = level->entries;
+            entries.reserve(pending.size());
+            for (auto item : pending) {
+                entries.emplace_back(Entry{item, true});
+            }
+
+            // binary counter like merge of all levels that are not larger than the new one
+            while (!levels.empty() && levels.back()->entries.size() - levels.back()->numDead <= entries.size()) {
+                for (const auto &entry : levels.back()->entries) {
+                    if (entry.alive) {
+                        entries.emplace_back(entry);
+                    }
+                }
+
+                numDead -= levels.back()->numDead;
+                levels.pop_back();
+            }
+
+            build(entries, 0, entries.size(), 0);
+            for (std::size_t i = 0; i < entries.size(); ++i) {
+                locations[entries[i].item] = Location{level.get(), i};
+            }
+
+            pending.clear();
+            levels.emplace_back(std::move(level));
+        }
+
+        bool lessInDim(const value_type *lhs, const value_type *rhs, std::size_t dim) const {
+            if (dim == 0) {
+                return map.key_comp()(lhs->first, rhs->first);
+            }
+
+            return mappedComp(impl::mapped_key(lhs->second), impl::mapped_key(rhs->second));
+        }
+
+        void build(std::vector<Entry> &entries, std::size_t lo, std::size_t hi, std::size_t dim) const {
+            if (hi - lo <= 1) {
+                return;
+            }
+
+            auto mid = lo + (hi - lo) / 2;
+            std::nth_element(entries.begin() + lo, entries.begin() + mid, entries.begin() + hi,
+                             [this, dim](const Entry &lhs, const Entry &rhs) {
+                                 return lessInDim(lhs.item, rhs.item, dim);
+                             });
+            build(entries, lo, mid, 1 - dim);
+            build(entries, mid + 1, hi, 1 - dim);
+        }
+
+        template<typename Fn>
+        void visit(const std::vector<Entry> &entries, std::size_t lo, std::size_t hi, std::size_t dim,
+                   const Query &query, Fn &fn) const {
+            while (lo < hi) {
+                auto mid = lo + (hi - lo) / 2;
+                const auto &entry = entries[mid];
+                // the split value of an erased element is no longer accessible, so both subtrees are visited
+                bool goLeft = true, goRight = true;
+                if (entry.alive) {
+                    const auto &key = entry.item->first;
+                    const auto &mappedKey = impl::mapped_key(entry.item->second);
+                    const auto comp = map.key_comp();
+                    if (dim == 0) {
+                        goLeft = !comp(key, query.lo1);
+                        goRight = !comp(query.hi1, key);
+                    } else {
+                        goLeft = !mappedComp(mappedKey, query.lo2);
+                        goRight = !mappedComp(query.hi2, mappedKey);
+                    }
+
+                    if (!comp(key, query.lo1) && !comp(query.hi1, key) && !mappedComp(mappedKey, query.lo2) &&
+                        !mappedComp(query.hi2, mappedKey)) {
+                        fn(*entry.item);
+                    }
+                }
+
+                if (goLeft && goRight) {
+                    visit(entries, lo, mid, 1 - dim, query, fn);
+                }
+
+                if (goRight) {
+                    lo = mid + 1;
+                } else if (goLeft) {
+                    hi = mid;
+                } else {
+                    return;
+                }
+
+                dim = 1 - dim;
+            }
+        }
+
+        BaseMap map;
+        MappedCompare mappedComp;
+        mutable std::vector<std::unique_ptr<Level>> levels;
+        mutable std::vector<const value_type *> pending;
+        mutable std::unordered_map<const value_type *, Location> locations;
+        mutable std::size_t numDead = 0;
+    };
+
+    /**
+     * See member function range_indexed_map::swap
+     * @param lhs left hand side
+     * @param rhs right hand side
+     */
+    template<typename Key, typename T, typename Compare, typename MappedCompare>
+    void swap(range_indexed_map<Key, T, Compare, MappedCompare> &lhs,
+              range_indexed_map<Key, T, Compare, MappedCompare> &rhs) noexcept {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_RANGE_INDEXED_MAP_HPP
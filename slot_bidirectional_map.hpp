@@ -0,0 +1,547 @@
+/**
+ * @file slot_bidirectional_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a bidirectional map that hands out stable 32 bit generational handles to its elements.
+ */
+
+#ifndef BIDIRECTIONALMAP_SLOT_BIDIRECTIONAL_MAP_HPP
+#define BIDIRECTIONALMAP_SLOT_BIDIRECTIONAL_MAP_HPP
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <optional>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Generational 32 bit handle to an element of a slot_bidirectional_map. The lower IndexBits bits contain
+     * the index of the slot, the upper bits contain the generation of the slot at the time of insertion.
+     * A default constructed handle is invalid.
+     */
+    class slot_handle {
+    public:
+        static constexpr unsigned IndexBits = 24;
+        static constexpr std::uint32_t MaxGeneration = (std::uint32_t(1) << (32 - IndexBits)) - 1;
+        static constexpr std::uint32_t MaxIndex = (std::uint32_t(1) << IndexBits) - 1;
+
+        constexpr slot_handle() noexcept = default;
+
+        constexpr slot_handle(std::uint32_t index, std::uint32_t generation) noexcept
+                : raw((generation << IndexBits) | index) {}
+
+        /**
+         * Reconstructs a handle from its raw value
+         */
+        static constexpr slot_handle from_value(std::uint32_t value) noexcept {
+            slot_handle res;
+            res.raw = value;
+            return res;
+        }
+
+        /**
+         * Raw value of the handle, e.g. for storing it in other data structures
+         */
+        [[nodiscard]] constexpr std::uint32_t value() const noexcept {
+            return raw;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t index() const noexcept {
+            return raw & MaxIndex;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t generation() const noexcept {
+            return raw >> IndexBits;
+        }
+
+        constexpr bool operator==(const slot_handle &other) const noexcept {
+            return raw == other.raw;
+        }
+
+        constexpr bool operator!=(const slot_handle &other) const noexcept {
+            return raw != other.raw;
+        }
+
+    private:
+        std::uint32_t raw = std::numeric_limits<std::uint32_t>::max();
+    };
+
+    /**
+     * @brief Bidirectional map whose elements are addressed by stable generational handles.
+     * @details The pairs are stored in a vector of slots. Forward and inverse lookup use two open addressing tables
+     * with linear probing that store handles. A handle stays valid until its element is erased, independent of
+     * insertions or rehashing. Resolving a handle and erasing by handle access only the slot vector, no hash table:
+     * erasing increments the generation of the slot, which turns all table entries and handles referring to the
+     * slot stale. Stale table entries are skipped by lookups and removed when the tables are rebuilt.
+     * A slot whose generation is exhausted is never reused, so a stale handle can never alias a later element.
+     *
+     * Retired slots bound the lifetime of the map: every slot can be erased MaxGeneration + 1 times, after which it
+     * stays in the slot vector without holding an element. Under sustained insertion and erasure the slot vector
+     * therefore grows by one slot per 256 erasures, and after about 2^32 erasures in total all MaxIndex slot indices
+     * are used up and emplace throws std::length_error. clear() keeps retired slots to preserve the guarantee
+     * above, reset() recycles them at the price of letting old handles alias new elements.
+     * ```
+     * bimap::slot_bidirectional_map<std::string, int> map;
+     * auto [handle, inserted] = map.emplace("a", 1);
+     * auto [name, id] = map.get(handle);
+     * map.erase(handle);
+     * map.contains(handle); // false
+     * ```
+     * @tparam ForwardKey type of forward keys
+     * @tparam InverseKey type of inverse keys
+     * @tparam ForwardHash hash function for forward keys
+     * @tparam InverseHash hash function for inverse keys
+     * @tparam ForwardEqual equality comparator for forward keys
+     * @tparam InverseEqual equality comparator for inverse keys
+     */
+    template<typename ForwardKey, typename InverseKey,
+             typename ForwardHash = std::hash<ForwardKey>, typename InverseHash = std::hash<InverseKey>,
+             typename ForwardEqual = std::equal_to<ForwardKey>, typename InverseEqual = std::equal_to<InverseKey>>
+    class slot_bidirectional_map {
+        struct Slot {
+            std::optional<std::pair<ForwardKey, InverseKey>> item;
+            std::uint32_t generation = 0;
+        };
+
+        static constexpr std::uint32_t Empty = slot_handle().value();
+        using Table = std::vector<std::uint32_t>;
+
+    public:
+        using handle = slot_handle;
+        using inverse_view = impl::inverse_view<slot_bidirectional_map, InverseKey, ForwardKey, false>;
+        using const_inverse_view = impl::inverse_view<slot_bidirectional_map, InverseKey, ForwardKey, true>;
+
+        /**
+         * @brief forward iterator over the contained pairs in slot order
+         */
+        class iterator {
+        public:
+            using value_type = std::pair<const ForwardKey &, const InverseKey &>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            iterator(const Slot *first, const Slot *pos, const Slot *last) noexcept
+                    : pos(pos), last(last), first(first) {
+                skip();
+            }
+
+            reference operator*() const noexcept {
+                return {pos->item->first, pos->item->second};
+            }
+
+            pointer operator->() const noexcept {
+                return {**this};
+            }
+
+            iterator &operator++() noexcept {
+                ++pos;
+                skip();
+                return *this;
+            }
+
+            iterator operator++(int) noexcept {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            /**
+             * Handle of the current element
+             */
+            [[nodiscard]] handle get_handle() const noexcept {
+                return handle(static_cast<std::uint32_t>(pos - first), pos->generation);
+            }
+
+            bool operator==(const iterator &other) const noexcept {
+                return pos == other.pos;
+            }
+
+            bool operator!=(const iterator &other) const noexcept {
+                return pos != other.pos;
+            }
+
+        private:
+            void skip() noexcept {
+                while (pos != last && !pos->item) {
+                    ++pos;
+                }
+            }
+
+            const Slot *pos = nullptr;
+            const Slot *last = nullptr;
+            const Slot *first = nullptr;
+        };
+
+        slot_bidirectional_map() = default;
+
+        /**
+         * Copy constructor. Handles of other are valid for the copy
+         * @param other source
+         */
+        slot_bidirectional_map(const slot_bidirectional_map &other)
+                : slots(other.slots), freeSlots(other.freeSlots), forwardTable(other.forwardTable),
+                  inverseTable(other.inverseTable), forwardUsed(other.forwardUsed), inverseUsed(other.inverseUsed),
+                  numItems(other.numItems) {
+            // copying a vector does not copy its capacity
+            freeSlots.reserve(slots.capacity());
+        }
+
+        slot_bidirectional_map(slot_bidirectional_map &&) noexcept = default;
+
+        /**
+         * Assignment operator
+         * @param other source
+         * @return reference to *this
+         */
+        slot_bidirectional_map &operator=(const slot_bidirectional_map &other) {
+            if (this != &other) {
+                *this = slot_bidirectional_map(other);
+            }
+
+            return *this;
+        }
+
+        slot_bidirectional_map &operator=(slot_bidirectional_map &&) noexcept = default;
+
+        iterator begin() const noexcept {
+            return {slots.data(), slots.data(), slots.data() + slots.size()};
+        }
+
+        iterator end() const noexcept {
+            return {slots.data(), slots.data() + slots.size(), slots.data() + slots.size()};
+        }
+
+        /**
+         * Number of contained pairs
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return numItems;
+        }
+
+        /**
+         * Whether the map is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return numItems == 0;
+        }
+
+        /**
+         * Constructs a pair in place if neither key is already contained
+         * @tparam ARGS argument types
+         * @param args arguments used to construct the pair
+         * @return std::pair(handle of the inserted or already existing element, bool whether insertion happened)
+         * @throws std::length_error if all slot indices are in use or retired
+         */
+        template<typename ...ARGS>
+        auto emplace(ARGS &&...args) -> std::pair<handle, bool> {
+            std::pair<ForwardKey, InverseKey> tmp(std::forward<ARGS>(args)...);
+            if (auto res = find(tmp.first); res != handle()) {
+                return {res, false};
+            }
+
+            if (auto res = inverse().find(tmp.second); res != handle()) {
+                return {res, false};
+            }
+
+            if (freeSlots.empty() && slots.size() > handle::MaxIndex - 1) {
+                throw std::length_error("slot bidirectional map out of slot indices");
+            }
+
+            if (2 * (std::max(forwardUsed, inverseUsed) + 1) > forwardTable.size()) {
+                // either grows the tables or only removes stale entries
+                rebuild(std::max(forwardTable.size(), capacityFor(2 * (numItems + 1))));
+            }
+
+            std::uint32_t index;
+            if (freeSlots.empty()) {
+                index = static_cast<std::uint32_t>(slots.size());
+                slots.emplace_back();
+                try {
+                    // erase pushes to freeSlots and must not allocate
+                    freeSlots.reserve(slots.capacity());
+                } catch (...) {
+                    slots.pop_back();
+                    throw;
+                }
+            } else {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+
+            auto &slot = slots[index];
+            slot.item.emplace(std::move(tmp));
+            const handle res(index, slot.generation);
+            insertEntry<false>(res);
+            insertEntry<true>(res);
+            ++numItems;
+            return {res, true};
+        }
+
+        /**
+         * Finds the element with the given forward key
+         * @param key key used for lookup
+         * @return handle of the found element or an invalid handle if key cannot be found
+         */
+        handle find(const ForwardKey &key) const {
+            return lookup<false>(key);
+        }
+
+        /**
+         * Check if a certain key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        bool contains(const ForwardKey &key) const {
+            return find(key) != handle();
+        }
+
+        /**
+         * Checks in O(1) whether a handle refers to a contained element. Does not access any hash table
+         * @param h handle
+         * @return true if the element of the handle has not been erased
+         */
+        bool contains(handle h) const noexcept {
+            return h.index() < slots.size() && slots[h.index()].item && slots[h.index()].generation == h.generation();
+        }
+
+        /**
+         * Returns the value found by the given key
+         * @param key key used for lookup
+         * @return reference to found value
+         * @throws std::out_of_range if key does not exist
+         */
+        const InverseKey &at(const ForwardKey &key) const {
+            auto res = find(key);
+            if (res == handle()) {
+                throw std::out_of_range("slot bidirectional map key not found");
+            }
+
+            return get(res).second;
+        }
+
+        /**
+         * Resolves a handle in O(1). Does not access any hash table
+         * @param h handle
+         * @return pair of references to forward key and inverse key
+         * @throws std::out_of_range if the handle is stale or invalid
+         */
+        auto get(handle h) const -> std::pair<const ForwardKey &, const InverseKey &> {
+            if (!contains(h)) {
+                throw std::out_of_range("stale or invalid slot handle");
+            }
+
+            const auto &item = *slots[h.index()].item;
+            return {item.first, item.second};
+        }
+
+        /**
+         * Erases an element in O(1). Does not access any hash table
+         * @param h handle of the element
+         * @return true if the element was erased, false if the handle is stale or invalid
+         */
+        bool erase(handle h) noexcept {
+            if (!contains(h)) {
+                return false;
+            }
+
+            auto &slot = slots[h.index()];
+            slot.item.reset();
+            // an exhausted slot is retired, so its handles can never become valid again
+            if (++slot.generation <= handle::MaxGeneration) {
+                freeSlots.push_back(h.index());
+            }
+
+            --numItems;
+            return true;
+        }
+
+        /**
+         * Erases the element with the given key
+         * @param key key of the element
+         * @return number of erased elements (0 or 1)
+         */
+        std::size_t erase(const ForwardKey &key) {
+            return erase(find(key)) ? 1 : 0;
+        }
+
+        /**
+         * Erases all elements. All handles become stale
+         */
+        void clear() noexcept {
+            for (auto &slot : slots) {
+                if (slot.item) {
+                    erase(handle(static_cast<std::uint32_t>(&slot - slots.data()), slot.generation));
+                }
+            }
+
+            std::fill(forwardTable.begin(), forwardTable.end(), Empty);
+            std::fill(inverseTable.begin(), inverseTable.end(), Empty);
+            forwardUsed = inverseUsed = 0;
+        }
+
+        /**
+         * Erases all elements and returns all slots to their initial state, including retired ones. Unlike clear(),
+         * handles obtained before the call must be discarded, they may refer to elements inserted afterwards
+         */
+        void reset() noexcept {
+            slots.clear();
+            freeSlots.clear();
+            std::fill(forwardTable.begin(), forwardTable.end(), Empty);
+            std::fill(inverseTable.begin(), inverseTable.end(), Empty);
+            forwardUsed = inverseUsed = 0;
+            numItems = 0;
+        }
+
+        /**
+         * Reserves space for the given number of elements in both lookup tables
+         * @param count number of elements
+         */
+        void reserve(std::size_t count) {
+            if (2 * count > forwardTable.size()) {
+                rebuild(capacityFor(count));
+            }
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return view for lookup from inverse keys to handles and forward keys
+         */
+        inverse_view inverse() noexcept {
+            return inverse_view(*this);
+        }
+
+        /**
+         * Read only access to inverse lookup
+         * @return view for lookup from inverse keys to handles and forward keys
+         */
+        const_inverse_view inverse() const noexcept {
+            return const_inverse_view(*this);
+        }
+
+    private:
+        template<typename, typename, typename, bool>
+        friend class impl::inverse_view;
+
+        handle inverseFind(const InverseKey &key) const {
+            return lookup<true>(key);
+        }
+
+        bool inverseContains(const InverseKey &key) const {
+            return inverseFind(key) != handle();
+        }
+
+        const ForwardKey &inverseAt(const InverseKey &key) const {
+            auto res = inverseFind(key);
+            if (res == handle()) {
+                throw std::out_of_range("slot bidirectional map key not found");
+            }
+
+            return get(res).first;
+        }
+
+        std::size_t inverseErase(const InverseKey &key) {
+            return erase(inverseFind(key)) ? 1 : 0;
+        }
+
+        static std::size_t capacityFor(std::size_t count) noexcept {
+            std::size_t capacity = 16;
+            while (capacity < 2 * count) {
+                capacity *= 2;
+            }
+
+            return capacity;
+        }
+
+        template<bool Inverse>
+        static std::size_t home(const std::conditional_t<Inverse, InverseKey, ForwardKey> &key, std::size_t mask) {
+            using Hash = std::conditional_t<Inverse, InverseHash, ForwardHash>;
+            return static_cast<std::size_t>(impl::mix_bits(static_cast<std::uint64_t>(Hash{}(key)))) & mask;
+        }
+
+        template<bool Inverse>
+        static const auto &keyOf(const std::pair<ForwardKey, InverseKey> &item) noexcept {
+            if constexpr (Inverse) {
+                return item.second;
+            } else {
+                return item.first;
+            }
+        }
+
+        template<bool Inverse>
+        handle lookup(const std::conditional_t<Inverse, InverseKey, ForwardKey> &key) const {
+            using Equal = std::conditional_t<Inverse, InverseEqual, ForwardEqual>;
+            const auto &table = Inverse ? inverseTable : forwardTable;
+            if (table.empty()) {
+                return {};
+            }
+
+            const auto mask = table.size() - 1;
+            for (auto pos = home<Inverse>(key, mask); table[pos] != Empty; pos = (pos + 1) & mask) {
+                const auto h = handle::from_value(table[pos]);
+                if (contains(h) && Equal{}(keyOf<Inverse>(*slots[h.index()].item), key)) {
+                    return h;
+                }
+            }
+
+            return {};
+        }
+
+        /**
+         * Inserts a handle whose key is known not to be contained. Reuses stale entries on the probe sequence
+         */
+        template<bool Inverse>
+        void insertEntry(handle h) {
+            auto &table = Inverse ? inverseTable : forwardTable;
+            const auto mask = table.size() - 1;
+            auto pos = home<Inverse>(keyOf<Inverse>(*slots[h.index()].item), mask);
+            while (table[pos] != Empty && contains(handle::from_value(table[pos]))) {
+                pos = (pos + 1) & mask;
+            }
+
+            if (table[pos] == Empty) {
+                ++(Inverse ? inverseUsed : forwardUsed);
+            }
+
+            table[pos] = h.value();
+        }
+
+        /**
+         * Rebuilds both tables from the live slots, which removes all stale entries
+         */
+        void rebuild(std::size_t capacity) {
+            forwardTable.assign(capacity, Empty);
+            inverseTable.assign(capacity, Empty);
+            forwardUsed = inverseUsed = 0;
+            for (std::size_t i = 0; i < slots.size(); ++i) {
+                if (slots[i].item) {
+                    const handle h(static_cast<std::uint32_t>(i), slots[i].generation);
+                    insertEntry<false>(h);
+                    insertEntry<true>(h);
+                }
+            }
+        }
+
+        std::vector<Slot> slots;
+        // capacity is kept at least slots.size(), so erase never allocates
+        std::vector<std::uint32_t> freeSlots;
+        Table forwardTable;
+        Table inverseTable;
+        std::size_t forwardUsed = 0;
+        std::size_t inverseUsed = 0;
+        std::size_t numItems = 0;
+    };
+}
+
+#endif //BIDIRECTIONALMAP_SLOT_BIDIRECTIONAL_MAP_HPP
@@ -0,0 +1,579 @@
+/**
+ * @file static_bidirectional_map.hpp
+ * @author Tim Luchterhand
+ * @date 2026-10-17
+ * @brief This file contains a fixed capacity bidirectional map that never allocates memory. It is intended for
+ * latency critical threads that must not call the allocator.
+ */
+
+#ifndef BIDIRECTIONALMAP_STATIC_BIDIRECTIONAL_MAP_HPP
+#define BIDIRECTIONALMAP_STATIC_BIDIRECTIONAL_MAP_HPP
+
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+
+#include "bidirectional_map.hpp"
+
+namespace bimap {
+    /**
+     * @brief Bidirectional map with fixed capacity whose storage is entirely contained in the object.
+     * @details The pairs are stored densely in an inline array. Forward and inverse lookup use two inline open
+     * addressing tables with linear probing that contain indices into this array. The tables have at least twice as
+     * many slots as the capacity, so the load factor never exceeds 0.5. Erasure uses backward shift deletion, i.e.
+     * no tombstones accumulate. No operation allocates memory. All operations are O(1) on average and bounded by the
+     * table size in the worst case.
+     * Erasing moves the last pair into the erased position, which invalidates iterators to the last pair.
+     * ```
+     * bimap::static_bidirectional_map<int, int, 128> map;
+     * if (!map.try_emplace(1, 2).second) {...} // full or already contained
+     * map.inverse().at(2);
+     * ```
+     * @tparam ForwardKey type of forward keys
+     * @tparam InverseKey type of inverse keys
+     * @tparam Capacity maximum number of pairs
+     * @tparam ForwardHash hash function for forward keys
+     * @tparam InverseHash hash function for inverse keys
+     */
+    template<typename ForwardKey, typename InverseKey, std::size_t Capacity,
+             typename ForwardHash = std::hash<ForwardKey>, typename InverseHash = std::hash<InverseKey>>
+    class static_bidirectional_map {
+        static_assert(Capacity > 0, "capacity must not be zero");
+        static_assert(Capacity < std::numeric_limits<std::uint32_t>::max(), "capacity too large");
+        using Index = std::uint32_t;
+        using Item = std::pair<ForwardKey, InverseKey>;
+        static constexpr Index Empty = std::numeric_limits<Index>::max();
+
+        static constexpr std::size_t tableSize() noexcept {
+            std::size_t size = 2;
+            while (size < 2 * Capacity) {
+                size *= 2;
+            }
+
+            return size;
+        }
+
+        static constexpr unsigned tableShift() noexcept {
+            unsigned shift = 64;
+            for (std::size_t size = tableSize(); size > 1; size /= 2) {
+                --shift;
+            }
+
+            return shift;
+        }
+
+        static constexpr std::size_t TableSize = tableSize();
+        static constexpr std::size_t Mask = TableSize - 1;
+        using Table = std::array<Index, TableSize>;
+        static constexpr bool NothrowHash = noexcept(ForwardHash{}(std::declval<const ForwardKey &>())) &&
+                                            noexcept(InverseHash{}(std::declval<const InverseKey &>()));
+        static constexpr bool NothrowCompare = noexcept(std::declval<const ForwardKey &>() ==
+                                                        std::declval<const ForwardKey &>()) &&
+                                               noexcept(std::declval<const InverseKey &>() ==
+                                                        std::declval<const InverseKey &>());
+        static constexpr bool NothrowSwap = std::is_nothrow_move_constructible_v<Item> &&
+                                            std::is_nothrow_swappable_v<Item>;
+
+        template<bool Inverse>
+        class Iterator {
+            friend class static_bidirectional_map;
+            using Key = std::conditional_t<Inverse, InverseKey, ForwardKey>;
+            using Value = std::conditional_t<Inverse, ForwardKey, InverseKey>;
+        public:
+            using value_type = std::pair<const Key &, const Value &>;
+            using reference = value_type;
+            using pointer = impl::arrow_proxy<value_type>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+
+            constexpr Iterator() noexcept = default;
+
+            constexpr explicit Iterator(const Item *item) noexcept: item(item) {}
+
+            reference operator*() const noexcept {
+                if constexpr (Inverse) {
+                    return {item->second, item->first};
+                } else {
+                    return {item->first, item->second};
+                }
+            }
+
+            pointer operator->() const noexcept {
+                return {**this};
+            }
+
+            Iterator &operator++() noexcept {
+                ++item;
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept {
+                auto tmp = *this;
+                ++item;
+                return tmp;
+            }
+
+            Iterator &operator--() noexcept {
+                --item;
+                return *this;
+            }
+
+            Iterator operator--(int) noexcept {
+                auto tmp = *this;
+                --item;
+                return tmp;
+            }
+
+            constexpr bool operator==(const Iterator &other) const noexcept {
+                return item == other.item;
+            }
+
+            constexpr bool operator!=(const Iterator &other) const noexcept {
+                return item != other.item;
+            }
+
+        private:
+            const Item *item = nullptr;
+        };
+
+    public:
+        using iterator = Iterator<false>;
+        using inverse_iterator = Iterator<true>;
+        using inverse_view = impl::inverse_view<static_bidirectional_map, InverseKey, ForwardKey, false>;
+        using const_inverse_view = impl::inverse_view<static_bidirectional_map, InverseKey, ForwardKey, true>;
+
+        /**
+         * Creates an empty map
+         */
+        static_bidirectional_map() noexcept {
+            forwardTable.fill(Empty);
+            inverseTable.fill(Empty);
+        }
+
+        /**
+         * Copy constructor
+         * @param other source
+         */
+        static_bidirectional_map(const static_bidirectional_map &other)
+                noexcept(std::is_nothrow_copy_constructible_v<Item>) : forwardTable(other.forwardTable),
+                                                                        inverseTable(other.inverseTable) {
+            try {
+                for (; numItems < other.numItems; ++numItems) {
+                    new(items() + numItems) Item(other.items()[numItems]);
+                }
+            } catch (...) {
+                // the destructor does not run if the constructor throws
+                clear();
+                throw;
+            }
+        }
+
+        /**
+         * Assignment operator. Strong exception guarantee if Item is nothrow move constructible and swappable
+         * @param other source
+         * @return reference to *this
+         */
+        static_bidirectional_map &operator=(const static_bidirectional_map &other)
+                noexcept(std::is_nothrow_copy_constructible_v<Item> && NothrowSwap) {
+            if (this != &other) {
+                static_bidirectional_map tmp(other);
+                swap(tmp);
+            }
+
+            return *this;
+        }
+
+        ~static_bidirectional_map() {
+            clear();
+        }
+
+        iterator begin() const noexcept {
+            return iterator(items());
+        }
+
+        iterator end() const noexcept {
+            return iterator(items() + numItems);
+        }
+
+        /**
+         * Number of contained pairs
+         */
+        [[nodiscard]] std::size_t size() const noexcept {
+            return numItems;
+        }
+
+        /**
+         * Whether the map is empty
+         */
+        [[nodiscard]] bool empty() const noexcept {
+            return numItems == 0;
+        }
+
+        /**
+         * Whether no more pairs can be inserted
+         */
+        [[nodiscard]] bool full() const noexcept {
+            return numItems == Capacity;
+        }
+
+        /**
+         * Maximum number of pairs
+         */
+        static constexpr std::size_t capacity() noexcept {
+            return Capacity;
+        }
+
+        /**
+         * Inserts a pair if neither key is already contained and the map is not full. Never allocates memory
+         * @param forwardKey forward key
+         * @param inverseKey inverse key
+         * @return pair(iterator to the inserted or already existing pair, whether insertion happened). If the map is
+         * full and neither key is contained, the iterator is end()
+         */
+        template<typename K1, typename K2>
+        auto try_emplace(K1 &&forwardKey, K2 &&inverseKey)
+        noexcept(NothrowHash && NothrowCompare && std::is_nothrow_constructible_v<ForwardKey, K1 &&> &&
+                 std::is_nothrow_constructible_v<InverseKey, K2 &&>) -> std::pair<iterator, bool> {
+            const auto forwardSlot = findSlot<false>(forwardKey);
+            if (forwardTable[forwardSlot] != Empty) {
+                return {iterator(items() + forwardTable[forwardSlot]), false};
+            }
+
+            const auto inverseSlot = findSlot<true>(inverseKey);
+            if (inverseTable[inverseSlot] != Empty) {
+                return {iterator(items() + inverseTable[inverseSlot]), false};
+            }
+
+            if (full()) {
+                return {end(), false};
+            }
+
+            auto item = new(items() + numItems) Item(std::forward<K1>(forwardKey), std::forward<K2>(inverseKey));
+            forwardTable[forwardSlot] = static_cast<Index>(numItems);
+            inverseTable[inverseSlot] = static_cast<Index>(numItems);
+            ++numItems;
+            return {iterator(item), true};
+        }
+
+        /**
+         * Finds the pair with the given forward key
+         * @param key key used for lookup
+         * @return iterator to the found pair or end() if key cannot be found
+         */
+        iterator find(const ForwardKey &key) const noexcept(NothrowHash && NothrowCompare) {
+            auto index = forwardTable[findSlot<false>(key)];
+            return index == Empty ? end() : iterator(items() + index);
+        }
+
+        /**
+         * Check if a certain key can be found
+         * @param key key used for lookup
+         * @return true if key can be found, false otherwise
+         */
+        bool contains(const ForwardKey &key) const noexcept(NothrowHash && NothrowCompare) {
+            return find(key) != end();
+        }
+
+        /**
+         * Returns the value found by the given key
+         * @param key key used for lookup
+         * @return reference to found value
+         * @throws std::out_of_range if key does not exist
+         */
+        const InverseKey &at(const ForwardKey &key) const {
+            auto res = find(key);
+            if (res == end()) {
+                throw std::out_of_range("static bidirectional map key not found");
+            }
+
+            return res->second;
+        }
+
+        /**
+         * Erases the pair with the given key. The last pair is moved into the erased position. If moving it throws,
+         * the map is left empty
+         * @param key key of the pair to erase
+         * @return number of erased pairs (0 or 1)
+         */
+        std::size_t erase(const ForwardKey &key) noexcept(NothrowHash && NothrowCompare &&
+                                                          std::is_nothrow_move_assignable_v<Item>) {
+            auto index = forwardTable[findSlot<false>(key)];
+            if (index == Empty) {
+                return 0;
+            }
+
+            eraseIndex(index);
+            return 1;
+        }
+
+        /**
+         * Erases all pairs
+         */
+        void clear() noexcept {
+            for (std::size_t i = 0; i < numItems; ++i) {
+                items()[i].~Item();
+            }
+
+            numItems = 0;
+            forwardTable.fill(Empty);
+            inverseTable.fill(Empty);
+        }
+
+        /**
+         * Swaps the contents of the maps. If moving or swapping a pair throws, both maps are left empty
+         * @param other swap target
+         */
+        void swap(static_bidirectional_map &other) noexcept(NothrowSwap) {
+            using std::swap;
+            if (numItems > other.numItems) {
+                other.swap(*this);
+                return;
+            }
+
+            const auto common = numItems;
+            std::size_t i = 0;
+            if constexpr (NothrowSwap) {
+                swapItems(other, i);
+            } else {
+                try {
+                    swapItems(other, i);
+                } catch (...) {
+                    // [0, max(i, common)) of *this and [0, common) and [i, other.numItems) of other are alive
+                    for (std::size_t j = 0; j < std::max(i, common); ++j) {
+                        items()[j].~Item();
+                    }
+
+                    for (std::size_t j = 0; j < other.numItems; ++j) {
+                        if (j < common || j >= i) {
+                            other.items()[j].~Item();
+                        }
+                    }
+
+                    numItems = other.numItems = 0;
+                    forwardTable.fill(Empty);
+                    inverseTable.fill(Empty);
+                    other.forwardTable.fill(Empty);
+                    other.inverseTable.fill(Empty);
+                    throw;
+                }
+            }
+
+            numItems = other.numItems;
+            other.numItems = common;
+            swap(forwardTable, other.forwardTable);
+            swap(inverseTable, other.inverseTable);
+        }
+
+        /**
+         * Access to inverse lookup
+         * @return view for lookup from inverse keys to forward keys
+         */
+        inverse_view inverse() noexcept {
+            return inverse_view(*this);
+        }
+
+        /**
+         * Read only access to inverse lookup
+         * @return view for lookup from inverse keys to forward keys
+         */
+        const_inverse_view inverse() const noexcept {
+            return const_inverse_view(*this);
+        }
+
+    private:
+        template<typename, typename, typename, bool>
+        friend class impl::inverse_view;
+
+        inverse_iterator inverseBegin() const noexcept {
+            return inverse_iterator(items());
+        }
+
+        inverse_iterator inverseEnd() const noexcept {
+            return inverse_iterator(items() + numItems);
+        }
+
+        inverse_iterator inverseFind(const InverseKey &key) const noexcept(NothrowHash && NothrowCompare) {
+            auto index = inverseTable[findSlot<true>(key)];
+            return index == Empty ? inverseEnd() : inverse_iterator(items() + index);
+        }
+
+        bool inverseContains(const InverseKey &key) const noexcept(NothrowHash && NothrowCompare) {
+            return inverseFind(key) != inverseEnd();
+        }
+
+        const ForwardKey &inverseAt(const InverseKey &key) const {
+            auto res = inverseFind(key);
+            if (res == inverseEnd()) {
+                throw std::out_of_range("static bidirectional map key not found");
+            }
+
+            return res->second;
+        }
+
+        std::size_t inverseErase(const InverseKey &key) noexcept(NothrowHash && NothrowCompare &&
+                                                                 std::is_nothrow_move_assignable_v<Item>) {
+            auto index = inverseTable[findSlot<true>(key)];
+            if (index == Empty) {
+                return 0;
+            }
+
+            eraseIndex(index);
+            return 1;
+        }
+
+        Item *items() noexcept {
+            return std::launder(reinterpret_cast<Item *>(storage));
+        }
+
+        const Item *items() const noexcept {
+            return std::launder(reinterpret_cast<const Item *>(storage));
+        }
+
+        /**
+         * Swaps the first numItems pairs and moves the remaining pairs of the larger map other. i is the position
+         * reached, also if an exception is thrown
+         */
+        void swapItems(static_bidirectional_map &other, std::size_t &i) noexcept(NothrowSwap) {
+            using std::swap;
+            for (; i < numItems; ++i) {
+                swap(items()[i], other.items()[i]);
+            }
+
+            for (; i < other.numItems; ++i) {
+                new(items() + i) Item(std::move(other.items()[i]));
+                other.items()[i].~Item();
+            }
+        }
+
+        template<bool Inverse>
+        static std::size_t home(const std::conditional_t<Inverse, InverseKey, ForwardKey> &key)
+        noexcept(NothrowHash) {
+            using Hash = std::conditional_t<Inverse, InverseHash, ForwardHash>;
+            const auto hash = static_cast<std::uint64_t>(Hash{}(key));
+            return static_cast<std::size_t>((hash * 0x9e3779b97f4a7c15ull) >> tableShift());
+        }
+
+        template<bool Inverse>
+        static const auto &keyOf(const Item &item) noexcept {
+            if constexpr (Inverse) {
+                return item.second;
+            } else {
+                return item.first;
+            }
+        }
+
+        template<bool Inverse>
+        Table &table() noexcept {
+            if constexpr (Inverse) {
+                return inverseTable;
+            } else {
+                return forwardTable;
+            }
+        }
+
+        /**
+         * Slot containing the key or the empty slot where it would be inserted
+         */
+        template<bool Inverse>
+        std::size_t findSlot(const std::conditional_t<Inverse, InverseKey, ForwardKey> &key) const
+        noexcept(NothrowHash && NothrowCompare) {
+            const auto &tab = Inverse ? inverseTable : forwardTable;
+            auto slot = home<Inverse>(key);
+            while (tab[slot] != Empty && !(keyOf<Inverse>(items()[tab[slot]]) == key)) {
+                slot = (slot + 1) & Mask;
+            }
+
+            return slot;
+        }
+
+        /**
+         * Slot containing the given index
+         */
+        template<bool Inverse>
+        std::size_t slotOf(Index index) const noexcept(NothrowHash) {
+            const auto &tab = Inverse ? inverseTable : forwardTable;
+            auto slot = home<Inverse>(keyOf<Inverse>(items()[index]));
+            while (tab[slot] != index) {
+                slot = (slot + 1) & Mask;
+            }
+
+            return slot;
+        }
+
+        /**
+         * Backward shift deletion for linear probing
+         */
+        template<bool Inverse>
+        void removeSlot(std::size_t slot) noexcept(NothrowHash) {
+            auto &tab = table<Inverse>();
+            auto hole = slot;
+            for (auto curr = (slot + 1) & Mask; tab[curr] != Empty; curr = (curr + 1) & Mask) {
+                const auto desired = home<Inverse>(keyOf<Inverse>(items()[tab[curr]]));
+                // the entry may only be moved to the hole if the hole lies cyclically in [desired, curr)
+                const bool movable = hole <= curr ? (desired <= hole || desired > curr)
+                                                  : (desired <= hole && desired > curr);
+                if (movable) {
+                    tab[hole] = tab[curr];
+                    hole = curr;
+                }
+            }
+
+            tab[hole] = Empty;
+        }
+
+        void eraseIndex(Index index) noexcept(NothrowHash && std::is_nothrow_move_assignable_v<Item>) {
+            removeSlot<false>(slotOf<false>(index));
+            removeSlot<true>(slotOf<true>(index));
+            const auto last = static_cast<Index>(numItems - 1);
+            if (index != last) {
+                // the slots of the last pair are found by its keys, which are gone once it is moved from
+                const auto forwardSlot = slotOf<false>(last);
+                const auto inverseSlot = slotOf<true>(last);
+                if constexpr (std::is_nothrow_move_assignable_v<Item>) {
+                    items()[index] = std::move(items()[last]);
+                } else {
+                    try {
+                        items()[index] = std::move(items()[last]);
+                    } catch (...) {
+                        // both pairs are still alive but the erased pair is no longer in the tables
+                        clear();
+                        throw;
+                    }
+                }
+
+                forwardTable[forwardSlot] = index;
+                inverseTable[inverseSlot] = index;
+            }
+
+            items()[last].~Item();
+            --numItems;
+        }
+
+        alignas(Item) unsigned char storage[sizeof(Item) * Capacity];
+        std::size_t numItems = 0;
+        Table forwardTable;
+        Table inverseTable;
+    };
+
+    /**
+     * See member function static_bidirectional_map::swap
+     * @param lhs left hand side
+     * @param rhs right hand side
+     */
+    template<typename ForwardKey, typename InverseKey, std::size_t Capacity, typename ForwardHash,
+             typename InverseHash>
+    void swap(static_bidirectional_map<ForwardKey, InverseKey, Capacity, ForwardHash, InverseHash> &lhs,
+              static_bidirectional_map<ForwardKey, InverseKey, Capacity, ForwardHash, InverseHash> &rhs)
+    noexcept(noexcept(lhs.swap(rhs))) {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //BIDIRECTIONALMAP_STATIC_BIDIRECTIONAL_MAP_HPP